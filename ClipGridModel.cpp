@@ -1,43 +1,37 @@
 #include "ClipGridModel.h"
 
+#include <QtAlgorithms>
+
 ClipGridModel::ClipGridModel(QObject *parent)
     : QAbstractListModel(parent)
 {
-    m_clips.reserve(32);
-    for (int scene = 0; scene < 4; ++scene) {
-        for (int track = 0; track < 8; ++track) {
-            ClipCell cell;
-            cell.track = track;
-            cell.scene = scene;
-            m_clips.append(cell);
-        }
-    }
+    m_colors.fill(DefaultColor);
 }
 
 int ClipGridModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return m_clips.size();
+    return Cells;
 }
 
 QVariant ClipGridModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_clips.size())
+    const int row = index.row();
+    if (!index.isValid() || row < 0 || row >= Cells)
         return {};
 
-    const ClipCell &clip = m_clips.at(index.row());
     switch (role) {
     case TrackRole:
-        return clip.track;
+        return row % Tracks;
     case SceneRole:
-        return clip.scene;
+        return row / Tracks;
     case NameRole:
-        return clip.name;
+        return NamePool::instance().name(m_names[row]);
     case StateRole:
-        return clip.state;
+        return int(m_states[row]);
     case ColorRole:
-        return clip.color;
+        return QColor(m_colors[row]);
     default:
         return {};
     }
@@ -54,28 +48,83 @@ QHash<int, QByteArray> ClipGridModel::roleNames() const
     };
 }
 
-void ClipGridModel::setClipName(int track, int scene, const QString &name)
+void ClipGridModel::commitBatch()
+{
+    Q_ASSERT(m_batchDepth > 0);
+    if (--m_batchDepth > 0)
+        return;
+
+    int row = 0;
+    while (row < Cells) {
+        if (!m_dirty[row]) {
+            ++row;
+            continue;
+        }
+        const int first = row;
+        quint8 roles = 0;
+        while (row < Cells && m_dirty[row]) {
+            roles |= m_dirty[row];
+            m_dirty[row++] = 0;
+        }
+        emitRows(first, row - 1, roles);
+    }
+}
+
+void ClipGridModel::markDirty(int row, quint8 roles)
+{
+    if (m_batchDepth > 0)
+        m_dirty[row] |= roles;
+    else
+        emitRows(row, row, roles);
+}
+
+void ClipGridModel::emitRows(int first, int last, quint8 roles)
+{
+    ModelUpdateCoalescer::RoleMask changed = 0;
+    if (roles & DirtyName)
+        changed |= ModelUpdateCoalescer::roleMask(NameRole);
+    if (roles & DirtyState)
+        changed |= ModelUpdateCoalescer::roleMask(StateRole);
+    if (roles & DirtyColor)
+        changed |= ModelUpdateCoalescer::roleMask(ColorRole);
+    ++m_emissions;
+    ModelUpdateCoalescer::notify(m_coalescer, this, first, last, changed);
+}
+
+void ClipGridModel::setClipName(int track, int scene, NamePool::Handle name)
 {
     int idx = indexFor(track, scene);
     if (idx < 0)
         return;
-    if (m_clips[idx].name == name)
+    if (m_names[idx] == name)
         return;
-    m_clips[idx].name = name;
-    const QModelIndex modelIndex = this->index(idx, 0);
-    emit dataChanged(modelIndex, modelIndex, { NameRole });
+    m_names[idx] = name;
+    markDirty(idx, DirtyName);
 }
 
-void ClipGridModel::setClipColor(int track, int scene, const QColor &color)
+void ClipGridModel::setClipColor(int track, int scene, QRgb color)
 {
     int idx = indexFor(track, scene);
     if (idx < 0)
         return;
-    if (m_clips[idx].color == color)
+    if (m_colors[idx] == color)
         return;
-    m_clips[idx].color = color;
-    const QModelIndex modelIndex = this->index(idx, 0);
-    emit dataChanged(modelIndex, modelIndex, { ColorRole });
+    m_colors[idx] = color;
+    markDirty(idx, DirtyColor);
+}
+
+void ClipGridModel::setClipColors(quint32 mask, const QRgb *colors)
+{
+    Batch batch(this);
+    for (quint32 bits = mask; bits; bits &= bits - 1) {
+        const int idx = int(qCountTrailingZeroBits(bits));
+        if (idx >= Cells)
+            break;
+        if (m_colors[idx] == colors[idx])
+            continue;
+        m_colors[idx] = colors[idx];
+        markDirty(idx, DirtyColor);
+    }
 }
 
 void ClipGridModel::setClipState(int track, int scene, int state)
@@ -83,30 +132,43 @@ void ClipGridModel::setClipState(int track, int scene, int state)
     int idx = indexFor(track, scene);
     if (idx < 0)
         return;
-    if (m_clips[idx].state == state)
+    if (m_states[idx] == quint8(state))
         return;
-    m_clips[idx].state = state;
-    const QModelIndex modelIndex = this->index(idx, 0);
-    emit dataChanged(modelIndex, modelIndex, { StateRole });
+    m_states[idx] = quint8(state);
+    markDirty(idx, DirtyState);
 }
 
-void ClipGridModel::resetAll(const QColor &color)
+void ClipGridModel::resetAll(QRgb color)
 {
-    for (ClipCell &clip : m_clips) {
-        clip.color = color;
-        clip.name.clear();
-        clip.state = 0;
-    }
-    if (!m_clips.isEmpty()) {
-        const QModelIndex first = this->index(0, 0);
-        const QModelIndex last = this->index(m_clips.size() - 1, 0);
-        emit dataChanged(first, last);
+    Batch batch(this);
+    for (int row = 0; row < Cells; ++row) {
+        quint8 roles = 0;
+        if (m_colors[row] != color) {
+            m_colors[row] = color;
+            roles |= DirtyColor;
+        }
+        if (m_names[row] != NamePool::Empty) {
+            m_names[row] = NamePool::Empty;
+            roles |= DirtyName;
+        }
+        if (m_states[row] != 0) {
+            m_states[row] = 0;
+            roles |= DirtyState;
+        }
+        if (roles)
+            markDirty(row, roles);
     }
 }
 
+void ClipGridModel::markNames(NamePool &pool) const
+{
+    for (NamePool::Handle name : m_names)
+        pool.mark(name);
+}
+
 int ClipGridModel::indexFor(int track, int scene) const
 {
-    if (track < 0 || track >= 8 || scene < 0 || scene >= 4)
+    if (track < 0 || track >= Tracks || scene < 0 || scene >= Scenes)
         return -1;
-    return scene * 8 + track;
+    return scene * Tracks + track;
 }
@@ -3,16 +3,12 @@
 
 #include <QAbstractListModel>
 #include <QColor>
-#include <QVector>
 #include <QString>
 
-struct ClipCell {
-    int track = 0;
-    int scene = 0;
-    QString name;
-    int state = 0;
-    QColor color = QColor("#282828");
-};
+#include <array>
+
+#include "ModelUpdateCoalescer.h"
+#include "NamePool.h"
 
 class ClipGridModel : public QAbstractListModel
 {
@@ -27,21 +23,79 @@ public:
     };
     Q_ENUM(Roles)
 
+    static constexpr int Tracks = 8;
+    static constexpr int Scenes = 4;
+    static constexpr int Cells = Tracks * Scenes;
+    static constexpr QRgb DefaultColor = 0xFF282828;   // #282828
+
     explicit ClipGridModel(QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
-    void setClipName(int track, int scene, const QString &name);
-    void setClipColor(int track, int scene, const QColor &color);
+    // Batched updates: between beginBatch() and commitBatch() the setters
+    // only record which rows and roles changed. The outermost commit emits
+    // one dataChanged per run of consecutive changed rows, carrying the
+    // union of their roles; untouched rows are never included. Nests.
+    void beginBatch() { ++m_batchDepth; }
+    void commitBatch();
+    bool inBatch() const { return m_batchDepth > 0; }
+
+    class Batch
+    {
+    public:
+        explicit Batch(ClipGridModel *model) : m_model(model) { if (m_model) m_model->beginBatch(); }
+        ~Batch() { if (m_model) m_model->commitBatch(); }
+        Batch(const Batch &) = delete;
+        Batch &operator=(const Batch &) = delete;
+    private:
+        ClipGridModel *m_model;
+    };
+
+    void setClipName(int track, int scene, NamePool::Handle name);
+    void setClipName(int track, int scene, const QString &name)
+    {
+        setClipName(track, scene, NamePool::instance().intern(name));
+    }
+    void setClipColor(int track, int scene, QRgb color);
+    void setClipColor(int track, int scene, const QColor &color) { setClipColor(track, scene, color.rgb()); }
+    // Bit i of mask set: row i takes colors[i], as one batch
+    void setClipColors(quint32 mask, const QRgb *colors);
     void setClipState(int track, int scene, int state);
-    void resetAll(const QColor &color);
+    // Only cells that actually differ from the reset state are notified
+    void resetAll(QRgb color);
+    // Name handles still shown, for a NamePool sweep
+    void markNames(NamePool &pool) const;
+
+    // Change notifications handed on (to the coalescer, if any)
+    quint64 emissions() const { return m_emissions; }
+
+    // Route change notifications through a shared per-frame flush
+    void setCoalescer(ModelUpdateCoalescer *coalescer) { m_coalescer = coalescer; }
 
 private:
+    enum DirtyRole : quint8 {
+        DirtyName = 1 << 0,
+        DirtyState = 1 << 1,
+        DirtyColor = 1 << 2
+    };
+
     int indexFor(int track, int scene) const;
+    void markDirty(int row, quint8 roles);
+    void emitRows(int first, int last, quint8 roles);
 
-    QVector<ClipCell> m_clips;
+    // Struct of arrays indexed by row (scene * Tracks + track); track and
+    // scene are derived from the row. Colors and states together fit in
+    // three cache lines, so compares in bulk updates stay in L1. QVariants
+    // are only built in data().
+    std::array<QRgb, Cells> m_colors;
+    std::array<quint8, Cells> m_states {};
+    std::array<NamePool::Handle, Cells> m_names {};
+    ModelUpdateCoalescer *m_coalescer = nullptr;
+    std::array<quint8, Cells> m_dirty {};
+    int m_batchDepth = 0;
+    quint64 m_emissions = 0;
 };
 
 #endif // CLIPGRIDMODEL_H
@@ -0,0 +1,194 @@
+#include "ColorBatch.h"
+
+#include <cstring>
+
+#if defined(__ARM_NEON) && !defined(PUSHCLONE_COLOR_SCALAR)
+#include <arm_neon.h>
+#define PUSHCLONE_COLOR_NEON 1
+#elif (defined(__SSE2__) || defined(_M_X64)) && !defined(PUSHCLONE_COLOR_SCALAR)
+#include <emmintrin.h>
+#define PUSHCLONE_COLOR_SSE2 1
+#endif
+
+namespace {
+
+// ((msb & 0x7F) << 7 | (lsb & 0x7F)), clamped to 255
+inline quint32 component14(quint8 msb, quint8 lsb)
+{
+    const quint32 value = (quint32(msb & 0x7F) << 7) | quint32(lsb & 0x7F);
+    return value < 255 ? value : 255;
+}
+
+// (v * 255) / 127 == 2v + v / 127: doubling, plus one for full scale
+inline quint32 component7(quint8 value)
+{
+    const quint32 v = value & 0x7F;
+    return (v << 1) + (v == 0x7F ? 1 : 0);
+}
+
+inline QRgb pack(quint32 r, quint32 g, quint32 b)
+{
+    return 0xFF000000u | (r << 16) | (g << 8) | b;
+}
+
+#ifdef PUSHCLONE_COLOR_SSE2
+// Byte triplets already at 0-255 → QRgb
+inline void packTriplets(const quint8 *rgb, int count, QRgb *out)
+{
+    for (int i = 0; i < count; ++i)
+        out[i] = pack(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+}
+#endif
+
+} // namespace
+
+namespace ColorBatch {
+
+void decodeRgb14(const quint8 *data, int count, QRgb *out)
+{
+    int i = 0;
+#if defined(PUSHCLONE_COLOR_NEON)
+    // 8 colors: u16 lanes are (msb | lsb << 8), split per component
+    const uint16x8_t low7 = vdupq_n_u16(0x7F);
+    const uint16x8_t max8 = vdupq_n_u16(255);
+    const uint8x8_t alpha = vdup_n_u8(0xFF);
+    for (; i + 8 <= count; i += 8) {
+        // LD3 has no alignment requirement on aarch64
+        const uint16x8x3_t in = vld3q_u16(reinterpret_cast<const uint16_t *>(data + i * 6));
+        uint8x8_t c[3];
+        for (int k = 0; k < 3; ++k) {
+            const uint16x8_t msb = vandq_u16(in.val[k], low7);
+            const uint16x8_t lsb = vandq_u16(vshrq_n_u16(in.val[k], 8), low7);
+            c[k] = vmovn_u16(vminq_u16(vorrq_u16(vshlq_n_u16(msb, 7), lsb), max8));
+        }
+        uint8x8x4_t bgra;
+        bgra.val[0] = c[2];
+        bgra.val[1] = c[1];
+        bgra.val[2] = c[0];
+        bgra.val[3] = alpha;
+        vst4_u8(reinterpret_cast<uint8_t *>(out + i), bgra);
+    }
+#elif defined(PUSHCLONE_COLOR_SSE2)
+    // 8 components per register regardless of which color they belong to;
+    // the clamped bytes are then packed three at a time
+    const __m128i low7 = _mm_set1_epi16(0x7F);
+    const __m128i max8 = _mm_set1_epi16(255);
+    quint8 rgb[24];
+    for (; i + 8 <= count; i += 8) {
+        __m128i c[3];
+        for (int k = 0; k < 3; ++k) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 6 + k * 16));
+            const __m128i msb = _mm_and_si128(in, low7);
+            const __m128i lsb = _mm_and_si128(_mm_srli_epi16(in, 8), low7);
+            c[k] = _mm_min_epi16(_mm_or_si128(_mm_slli_epi16(msb, 7), lsb), max8);
+        }
+        const __m128i bytes01 = _mm_packus_epi16(c[0], c[1]);
+        const __m128i bytes2 = _mm_packus_epi16(c[2], c[2]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb), bytes01);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(rgb + 16), bytes2);
+        packTriplets(rgb, 8, out + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        const quint8 *p = data + i * 6;
+        out[i] = pack(component14(p[0], p[1]), component14(p[2], p[3]), component14(p[4], p[5]));
+    }
+}
+
+void decodeRgb7(const quint8 *data, int count, QRgb *out)
+{
+    int i = 0;
+#if defined(PUSHCLONE_COLOR_NEON)
+    const uint8x16_t low7 = vdupq_n_u8(0x7F);
+    const uint8x16_t alpha = vdupq_n_u8(0xFF);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x3_t in = vld3q_u8(data + i * 3);
+        uint8x16_t c[3];
+        for (int k = 0; k < 3; ++k) {
+            const uint8x16_t v = vandq_u8(in.val[k], low7);
+            const uint8x16_t full = vshrq_n_u8(vceqq_u8(v, low7), 7);   // 1 where v == 127
+            c[k] = vaddq_u8(vshlq_n_u8(v, 1), full);
+        }
+        uint8x16x4_t bgra;
+        bgra.val[0] = c[2];
+        bgra.val[1] = c[1];
+        bgra.val[2] = c[0];
+        bgra.val[3] = alpha;
+        vst4q_u8(reinterpret_cast<uint8_t *>(out + i), bgra);
+    }
+#elif defined(PUSHCLONE_COLOR_SSE2)
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    quint8 rgb[48];
+    for (; i + 16 <= count; i += 16) {
+        for (int k = 0; k < 3; ++k) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 3 + k * 16));
+            const __m128i v = _mm_and_si128(in, low7);
+            // compare yields -1 at full scale: subtracting it adds the one
+            const __m128i scaled = _mm_sub_epi8(_mm_add_epi8(v, v), _mm_cmpeq_epi8(v, low7));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(rgb + k * 16), scaled);
+        }
+        packTriplets(rgb, 16, out + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        const quint8 *p = data + i * 3;
+        out[i] = pack(component7(p[0]), component7(p[1]), component7(p[2]));
+    }
+}
+
+void decodeClips(const quint8 *data, int count, quint8 *states, QRgb *out)
+{
+    int i = 0;
+#if defined(PUSHCLONE_COLOR_NEON)
+    const uint8x16_t low7 = vdupq_n_u8(0x7F);
+    const uint8x16_t alpha = vdupq_n_u8(0xFF);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x4_t in = vld4q_u8(data + i * 4);
+        vst1q_u8(states + i, vandq_u8(in.val[0], low7));
+        uint8x16x4_t bgra;
+        bgra.val[0] = vshlq_n_u8(vandq_u8(in.val[3], low7), 1);
+        bgra.val[1] = vshlq_n_u8(vandq_u8(in.val[2], low7), 1);
+        bgra.val[2] = vshlq_n_u8(vandq_u8(in.val[1], low7), 1);
+        bgra.val[3] = alpha;
+        vst4q_u8(reinterpret_cast<uint8_t *>(out + i), bgra);
+    }
+#elif defined(PUSHCLONE_COLOR_SSE2)
+    // One clip per 32-bit lane: state | R << 8 | G << 16 | B << 24
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    const __m128i stateMask = _mm_set1_epi32(0x7F);
+    const __m128i greenMask = _mm_set1_epi32(0x0000FF00);
+    const __m128i redMask = _mm_set1_epi32(0x00FF0000);
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000u));
+    for (; i + 4 <= count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 4));
+        const __m128i v = _mm_and_si128(in, low7);
+        const __m128i x = _mm_add_epi8(v, v);
+        __m128i rgb = _mm_or_si128(_mm_srli_epi32(x, 24), alpha);                  // B
+        rgb = _mm_or_si128(rgb, _mm_and_si128(_mm_srli_epi32(x, 8), greenMask));   // G
+        rgb = _mm_or_si128(rgb, _mm_and_si128(_mm_slli_epi32(x, 8), redMask));     // R
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), rgb);
+
+        const __m128i s16 = _mm_packs_epi32(_mm_and_si128(in, stateMask), _mm_setzero_si128());
+        const int s8 = _mm_cvtsi128_si32(_mm_packus_epi16(s16, _mm_setzero_si128()));
+        std::memcpy(states + i, &s8, 4);
+    }
+#endif
+    for (; i < count; ++i) {
+        const quint8 *p = data + i * 4;
+        states[i] = p[0] & 0x7F;
+        out[i] = pack(quint32(p[1] & 0x7F) << 1, quint32(p[2] & 0x7F) << 1, quint32(p[3] & 0x7F) << 1);
+    }
+}
+
+const char *backend()
+{
+#if defined(PUSHCLONE_COLOR_NEON)
+    return "neon";
+#elif defined(PUSHCLONE_COLOR_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace ColorBatch
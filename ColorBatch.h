@@ -0,0 +1,32 @@
+#ifndef COLORBATCH_H
+#define COLORBATCH_H
+
+#include <QtGlobal>
+#include <QColor>
+
+// ═══════════════════════════════════════════════════════════
+// COLOR BATCH - Whole payloads of wire colors → packed QRgb
+// ═══════════════════════════════════════════════════════════
+// Grid and bulk clip frames carry up to 32 colors back to back. Decoding
+// them one pad at a time (three decode14Bit + qBound + QColor each) is
+// replaced by one pass over the payload:
+//   NEON (aarch64, Pi 5): deinterleaving loads, 8-16 colors per step
+//   SSE2 (x86-64):        component math 8-16 bytes per step
+//   scalar:               everything else, and the tails
+// Results are bit-exact with Protocol::rgbFrom14 / rgbFrom7 and with the
+// 7→8-bit shift of SESSION_RING_CLIPS; benchHotPaths checks all inputs.
+namespace ColorBatch {
+
+// count × [R msb, R lsb, G msb, G lsb, B msb, B lsb], each clamped to 255
+void decodeRgb14(const quint8 *data, int count, QRgb *out);
+// count × [R7, G7, B7] scaled to 0-255 (rgbFrom7)
+void decodeRgb7(const quint8 *data, int count, QRgb *out);
+// count × [state, R7, G7, B7] (SESSION_RING_CLIPS): state & 0x7F, RGB << 1
+void decodeClips(const quint8 *data, int count, quint8 *states, QRgb *out);
+
+// "neon", "sse2" or "scalar"
+const char *backend();
+
+} // namespace ColorBatch
+
+#endif // COLORBATCH_H
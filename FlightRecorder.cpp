@@ -0,0 +1,158 @@
+#include "FlightRecorder.h"
+#include "SerialCapture.h"
+
+#include <QCoreApplication>
+#include <QFile>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+char g_crashDumpPath[512] = {};
+
+#if defined(Q_OS_UNIX)
+bool writeAll(int fd, const void *data, size_t size) noexcept
+{
+    const char *p = static_cast<const char *>(data);
+    while (size > 0) {
+        const ssize_t n = ::write(fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        p += n;
+        size -= size_t(n);
+    }
+    return true;
+}
+
+void crashHandler(int sig)
+{
+    const int fd = ::open(g_crashDumpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        FlightRecorder::instance().dumpToFd(fd);
+        ::close(fd);
+        static const char note[] = "PushClone: flight recorder written\n";
+        writeAll(STDERR_FILENO, note, sizeof(note) - 1);
+    }
+    // SA_RESETHAND restored the default action: crash for real
+    ::raise(sig);
+}
+#endif
+
+} // namespace
+
+FlightRecorder &FlightRecorder::instance()
+{
+    static FlightRecorder recorder;
+    return recorder;
+}
+
+FlightRecorder::FlightRecorder()
+    : m_windowNs(qint64(DefaultWindowSeconds) * 1000000000LL)
+{
+    const int seconds = qEnvironmentVariableIntValue("PUSHCLONE_FLIGHT_SECONDS");
+    if (seconds > 0)
+        setWindowSeconds(seconds);
+}
+
+void FlightRecorder::setWindowSeconds(int seconds)
+{
+    m_windowNs.store(qint64(qMax(1, seconds)) * 1000000000LL, std::memory_order_relaxed);
+}
+
+void FlightRecorder::record(qint64 timestampNs, const quint8 *data, int size) noexcept
+{
+    // Chunks larger than a slot are split; the pieces share the timestamp
+    while (size > 0) {
+        const int piece = qMin(size, int(SlotPayload));
+        const quint64 index = m_head.load(std::memory_order_relaxed);
+        quint8 *slot = m_slots[index & Mask].bytes;
+        const quint32 length = quint32(piece);
+        std::memcpy(slot, &timestampNs, sizeof(timestampNs));
+        std::memcpy(slot + 8, &length, sizeof(length));
+        std::memcpy(slot + SerialCapture::RecordHeaderSize, data, size_t(piece));
+        m_head.store(index + 1, std::memory_order_release);
+        data += piece;
+        size -= piece;
+    }
+    m_lastTimestampNs.store(timestampNs, std::memory_order_relaxed);
+}
+
+bool FlightRecorder::dumpToFd(int fd) const noexcept
+{
+#if defined(Q_OS_UNIX)
+    quint8 header[SerialCapture::HeaderSize];
+    SerialCapture::writeHeader(header, SerialCapture::FlagFlightRecorder);
+    if (!writeAll(fd, header, sizeof(header)))
+        return false;
+
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    const quint64 first = head > quint64(SlotCount) ? head - SlotCount : 0;
+    const qint64 cutoff = m_lastTimestampNs.load(std::memory_order_relaxed)
+                        - m_windowNs.load(std::memory_order_relaxed);
+
+    for (quint64 i = first; i < head; ++i) {
+        const quint8 *slot = m_slots[i & Mask].bytes;
+        qint64 timestampNs = 0;
+        quint32 length = 0;
+        std::memcpy(&timestampNs, slot, sizeof(timestampNs));
+        std::memcpy(&length, slot + 8, sizeof(length));
+        if (timestampNs < cutoff || length > quint32(SlotPayload))
+            continue;
+        if (!writeAll(fd, slot, SerialCapture::RecordHeaderSize + length))
+            return false;
+    }
+    return true;
+#else
+    Q_UNUSED(fd)
+    return false;
+#endif
+}
+
+bool FlightRecorder::dumpToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    file.flush();
+    return dumpToFd(file.handle());
+}
+
+void FlightRecorder::installCrashHandler()
+{
+    const QByteArray custom = qgetenv("PUSHCLONE_FLIGHT_FILE");
+    if (!custom.isEmpty())
+        std::snprintf(g_crashDumpPath, sizeof(g_crashDumpPath), "%s", custom.constData());
+    else
+        std::snprintf(g_crashDumpPath, sizeof(g_crashDumpPath), "/tmp/pushclone-flight-%lld.pcap",
+                      static_cast<long long>(QCoreApplication::applicationPid()));
+
+    // Touch the singleton now: a function-local static must not be
+    // initialised for the first time inside a signal handler
+    instance();
+
+#if defined(Q_OS_UNIX)
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = crashHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (int sig : { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT })
+        sigaction(sig, &action, nullptr);
+#endif
+}
+
+const char *FlightRecorder::crashDumpPath()
+{
+    return g_crashDumpPath;
+}
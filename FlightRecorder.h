@@ -0,0 +1,57 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <QtGlobal>
+#include <QString>
+
+#include <array>
+#include <atomic>
+
+// ═══════════════════════════════════════════════════════════
+// FLIGHT RECORDER - Last N seconds of raw RX, always on
+// ═══════════════════════════════════════════════════════════
+// Fixed slots laid out exactly like capture records, so a dump is a plain
+// sequence of write() calls: no allocation, no locks, no Qt. That keeps
+// dumpToFd() async-signal-safe and usable from the crash handler.
+class FlightRecorder
+{
+public:
+    static constexpr int SlotSize = 256;
+    static constexpr int SlotPayload = SlotSize - 12;   // after ts + length
+    static constexpr int SlotCount = 8192;              // ~2 MB, power of two
+    static constexpr int DefaultWindowSeconds = 30;
+
+    static FlightRecorder &instance();
+
+    // Single writer at a time (whichever thread owns the port)
+    void record(qint64 timestampNs, const quint8 *data, int size) noexcept;
+
+    void setWindowSeconds(int seconds);
+    int windowSeconds() const { return int(m_windowNs.load(std::memory_order_relaxed) / 1000000000LL); }
+
+    // Async-signal-safe: only write(2)
+    bool dumpToFd(int fd) const noexcept;
+    bool dumpToFile(const QString &path) const;
+
+    // SIGSEGV/SIGBUS/SIGILL/SIGFPE/SIGABRT dump to path, then re-raise.
+    // PUSHCLONE_FLIGHT_FILE overrides the default /tmp/pushclone-flight-<pid>.pcap
+    static void installCrashHandler();
+    static const char *crashDumpPath();
+
+private:
+    FlightRecorder();
+
+    static constexpr quint64 Mask = SlotCount - 1;
+    static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of two");
+
+    struct alignas(8) Slot {
+        quint8 bytes[SlotSize];   // qint64 ts | quint32 len | payload
+    };
+
+    std::array<Slot, SlotCount> m_slots;
+    std::atomic<quint64> m_head { 0 };
+    std::atomic<qint64> m_lastTimestampNs { 0 };
+    std::atomic<qint64> m_windowNs;
+};
+
+#endif // FLIGHTRECORDER_H
@@ -0,0 +1,106 @@
+#include "LatencyHistogram.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <cmath>
+
+int LatencyHistogram::bucketFor(quint64 value)
+{
+    if (value < quint64(LinearBuckets))
+        return int(value);
+    if (value > 0xFFFFFFFFull)
+        value = 0xFFFFFFFFull;
+
+    // msb >= 5; the four bits below it pick the sub-bucket
+    int msb = 31;
+    while (!(value & (quint64(1) << msb)))
+        --msb;
+    const int shift = msb - 4;
+    const int sub = int((value >> shift) & (SubBuckets - 1));
+    return LinearBuckets + (msb - 5) * SubBuckets + sub;
+}
+
+quint64 LatencyHistogram::bucketUpperBound(int bucket)
+{
+    if (bucket < LinearBuckets)
+        return quint64(bucket);
+    const int group = (bucket - LinearBuckets) / SubBuckets;   // msb - 5
+    const int sub = (bucket - LinearBuckets) % SubBuckets;
+    const int shift = group + 1;
+    return ((quint64(SubBuckets + sub + 1)) << shift) - 1;
+}
+
+void LatencyHistogram::record(quint64 value)
+{
+    ++m_buckets[bucketFor(value)];
+    ++m_count;
+    m_sum += value;
+    m_min = qMin(m_min, value);
+    m_max = qMax(m_max, value);
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0;
+    m_min = ~quint64(0);
+    m_max = 0;
+}
+
+quint64 LatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0)
+        return 0;
+
+    const double clamped = qBound(0.0, percent, 100.0);
+    const quint64 target = qMax<quint64>(1, quint64(std::ceil(clamped / 100.0 * double(m_count))));
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < BucketCount; ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= target)
+            return qMin(bucketUpperBound(bucket), m_max);
+    }
+    return m_max;
+}
+
+bool LatencyHistogram::dumpToFile(const QString &path, double unitScale) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    writeTo(out, unitScale);
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+void LatencyHistogram::writeTo(QTextStream &out, double unitScale) const
+{
+    out << QStringLiteral("%1 %2 %3 %4\n\n")
+               .arg(QStringLiteral("Value"), 12)
+               .arg(QStringLiteral("Percentile"), 14)
+               .arg(QStringLiteral("TotalCount"), 10)
+               .arg(QStringLiteral("1/(1-Percentile)"), 14);
+
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < BucketCount; ++bucket) {
+        if (!m_buckets[bucket])
+            continue;
+        seen += m_buckets[bucket];
+        const double fraction = double(seen) / double(m_count);
+        const double value = double(qMin(bucketUpperBound(bucket), m_max)) / unitScale;
+        out << QStringLiteral("%1 %2 %3").arg(value, 12, 'f', 3).arg(fraction, 14, 'f', 12).arg(seen, 10);
+        if (seen < m_count)
+            out << QStringLiteral(" %1").arg(1.0 / (1.0 - fraction), 14, 'f', 2);
+        out << '\n';
+    }
+
+    out << QStringLiteral("#[Mean    = %1, Min            = %2]\n")
+               .arg(mean() / unitScale, 12, 'f', 3).arg(double(min()) / unitScale, 12, 'f', 3);
+    out << QStringLiteral("#[Max     = %1, Total count    = %2]\n")
+               .arg(double(m_max) / unitScale, 12, 'f', 3).arg(m_count, 12);
+    out << QStringLiteral("#[Buckets = %1, SubBuckets     = %2]\n").arg(BucketCount, 12).arg(SubBuckets, 12);
+}
@@ -0,0 +1,54 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <QString>
+
+#include <array>
+
+class QTextStream;
+
+// ═══════════════════════════════════════════════════════════
+// LATENCY HISTOGRAM - Log-linear buckets, HdrHistogram style
+// ═══════════════════════════════════════════════════════════
+// Values below 32 get a bucket each; above that every power of two is
+// split into 16 sub-buckets, so any recorded value is reported within
+// ~6% of its true value across the whole 32-bit range. Recording is an
+// index computation and an increment: no allocation, no sorting.
+//
+// Units are the caller's (SerialController records microseconds).
+class LatencyHistogram
+{
+public:
+    static constexpr int LinearBuckets = 32;
+    static constexpr int SubBuckets = 16;
+    static constexpr int BucketCount = LinearBuckets + (32 - 5) * SubBuckets;
+
+    void record(quint64 value);
+    void reset();
+
+    quint64 count() const { return m_count; }
+    quint64 min() const { return m_count ? m_min : 0; }
+    quint64 max() const { return m_max; }
+    double mean() const { return m_count ? double(m_sum) / double(m_count) : 0.0; }
+    // Highest value equivalent to the bucket holding the given percentile
+    // (0-100), like HdrHistogram's getValueAtPercentile()
+    quint64 percentile(double percent) const;
+
+    // Percentile distribution in HdrHistogram's .hgrm text format, values
+    // divided by unitScale (e.g. 1000 to write microseconds as ms)
+    bool dumpToFile(const QString &path, double unitScale = 1.0) const;
+    void writeTo(QTextStream &out, double unitScale = 1.0) const;
+
+    static int bucketFor(quint64 value);
+    static quint64 bucketUpperBound(int bucket);
+
+private:
+    std::array<quint64, BucketCount> m_buckets {};
+    quint64 m_count = 0;
+    quint64 m_sum = 0;
+    quint64 m_min = ~quint64(0);
+    quint64 m_max = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
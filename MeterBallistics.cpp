@@ -0,0 +1,74 @@
+#include "MeterBallistics.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Levels are never negative, so bit patterns differ exactly when values do;
+// an integer OR keeps the "still moving" reduction vectorizable.
+inline quint32 floatBits(float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+} // namespace
+
+void MeterBallistics::setChannelCount(int channels)
+{
+    m_channels = qBound(0, (channels + 7) & ~7, MaxChannels);
+}
+
+bool MeterBallistics::step(float dtSeconds)
+{
+    const float dt = qBound(0.0f, dtSeconds, 0.1f);   // a stalled frame shouldn't jump
+    const float decay = std::exp(-dt / m_settings.releaseSeconds);
+    const float fall = m_settings.peakFallPerSecond * dt;
+    const float holdTime = m_settings.peakHoldSeconds;
+    const float clipThreshold = m_settings.clipThreshold;
+    const float epsilon = m_settings.settleEpsilon;
+
+    float *__restrict target = m_target.data();
+    float *__restrict level = m_level.data();
+    float *__restrict peak = m_peak.data();
+    float *__restrict holdLeft = m_holdLeft.data();
+    float *__restrict clip = m_clip.data();
+
+    const int channels = m_channels;
+    quint32 moving = 0;
+    for (int i = 0; i < channels; ++i) {
+        const float t = target[i];
+
+        // Attack: jump up to the target. Release: decay towards it, then snap
+        const float released = t + (level[i] - t) * decay;
+        const float l = released - t < epsilon ? t : released;
+        level[i] = l;
+
+        // Peak: a new maximum re-arms the hold; once it runs out the peak
+        // falls at a constant rate but never below the level.
+        const float p = peak[i];
+        const float countdown = holdLeft[i] - dt;
+        const float hold = l > p ? holdTime : countdown;
+        const float held = hold > 0.0f ? p : p - fall;
+        const float newPeak = held > l ? held : l;
+        holdLeft[i] = hold > 0.0f ? hold : 0.0f;
+        peak[i] = newPeak;
+
+        const float c = clip[i];
+        clip[i] = t >= clipThreshold ? 1.0f : c;
+
+        moving |= (floatBits(l) ^ floatBits(t)) | (floatBits(newPeak) ^ floatBits(l));
+    }
+    return moving != 0;
+}
+
+void MeterBallistics::reset()
+{
+    m_target.fill(0.0f);
+    m_level.fill(0.0f);
+    m_peak.fill(0.0f);
+    m_holdLeft.fill(0.0f);
+    m_clip.fill(0.0f);
+}
@@ -0,0 +1,65 @@
+#ifndef METERBALLISTICS_H
+#define METERBALLISTICS_H
+
+#include <QtGlobal>
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════
+// METER BALLISTICS - Push-style meter motion for all channels at once
+// ═══════════════════════════════════════════════════════════
+// Instant attack, exponential release towards the last received level,
+// peak hold with a timed fall-off and a sticky clip latch.
+//
+// State is struct-of-arrays and step() is one branch-free loop over every
+// channel (channel = track * 2 + L/R), so -O3 vectorizes it (NEON on the
+// Pi 5). Only the per-frame coefficients are computed outside the loop.
+class MeterBallistics
+{
+public:
+    static constexpr int MaxChannels = 256;     // 128 tracks × L/R
+
+    struct Settings {
+        float releaseSeconds = 0.30f;    // time constant of the fall back to target
+        float peakHoldSeconds = 1.50f;
+        float peakFallPerSecond = 0.50f; // full scale in two seconds
+        float clipThreshold = 1.0f;
+        float settleEpsilon = 1.0f / 1024.0f;
+    };
+
+    MeterBallistics() = default;
+
+    void setSettings(const Settings &settings) { m_settings = settings; }
+    const Settings &settings() const { return m_settings; }
+
+    // Channels stepped per frame, rounded up to a multiple of 8 lanes
+    void setChannelCount(int channels);
+    int channelCount() const { return m_channels; }
+
+    void setTarget(int channel, float value) { m_target[size_t(channel)] = value; }
+    float *targets() { return m_target.data(); }
+
+    // Advance every channel by dtSeconds. Returns false once all levels sit
+    // on their targets and no peak is above its level (nothing to repaint).
+    bool step(float dtSeconds);
+
+    float level(int channel) const { return m_level[size_t(channel)]; }
+    float peak(int channel) const { return m_peak[size_t(channel)]; }
+    bool clipped(int channel) const { return m_clip[size_t(channel)] != 0.0f; }
+
+    void clearClip(int channel) { m_clip[size_t(channel)] = 0.0f; }
+    void clearClips() { m_clip.fill(0.0f); }
+    void reset();
+
+private:
+    Settings m_settings;
+    int m_channels = 0;
+
+    alignas(16) std::array<float, MaxChannels> m_target {};
+    alignas(16) std::array<float, MaxChannels> m_level {};
+    alignas(16) std::array<float, MaxChannels> m_peak {};
+    alignas(16) std::array<float, MaxChannels> m_holdLeft {};
+    alignas(16) std::array<float, MaxChannels> m_clip {};
+};
+
+#endif // METERBALLISTICS_H
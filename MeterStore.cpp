@@ -0,0 +1,108 @@
+#include "MeterStore.h"
+#include "MonotonicClock.h"
+
+MeterStore::MeterStore(QObject *parent)
+    : QObject(parent)
+{
+}
+
+qreal MeterStore::level(int track, int channel) const
+{
+    if (!validTrack(track) || channel < 0 || channel > 1)
+        return 0.0;
+    return m_ballistics.level(track * 2 + channel);
+}
+
+qreal MeterStore::peak(int track, int channel) const
+{
+    if (!validTrack(track) || channel < 0 || channel > 1)
+        return 0.0;
+    return m_ballistics.peak(track * 2 + channel);
+}
+
+bool MeterStore::clipped(int track) const
+{
+    if (!validTrack(track))
+        return false;
+    return m_ballistics.clipped(track * 2) || m_ballistics.clipped(track * 2 + 1);
+}
+
+void MeterStore::clearClip(int track)
+{
+    if (!validTrack(track))
+        return;
+    m_ballistics.clearClip(track * 2);
+    m_ballistics.clearClip(track * 2 + 1);
+    ++m_revision;
+    emit levelsChanged();
+}
+
+void MeterStore::clearClips()
+{
+    m_ballistics.clearClips();
+    ++m_revision;
+    emit levelsChanged();
+}
+
+void MeterStore::setLevels7(int firstTrack, const quint8 *pairs, int count)
+{
+    if (!validTrack(firstTrack))
+        return;
+    count = qMin(count, MaxTracks - firstTrack);
+
+    float *out = m_ballistics.targets() + firstTrack * 2;
+    for (int i = 0; i < count * 2; ++i)
+        out[i] = float(pairs[i] & 0x7F) * (1.0f / 127.0f);
+
+    if (firstTrack + count > m_trackCount) {
+        m_trackCount = firstTrack + count;
+        m_ballistics.setChannelCount(m_trackCount * 2);
+    }
+    m_targetsChanged = true;
+    ++m_updates;
+
+    // While animating the next frame picks the targets up; at rest nothing
+    // renders, so step once from the event loop to get frames going again
+    if (!m_moving && !m_kickScheduled) {
+        m_kickScheduled = true;
+        QMetaObject::invokeMethod(this, &MeterStore::kick, Qt::QueuedConnection);
+    }
+}
+
+void MeterStore::kick()
+{
+    m_kickScheduled = false;
+    advanceFrame(MonotonicClock::nowNs());
+}
+
+void MeterStore::advanceFrame(qint64 nowNs)
+{
+    if (!m_moving && !m_targetsChanged)
+        return;
+
+    // First step after a rest: dt 0 rather than the whole rest (clamped to
+    // 0.1 s), which would run hold countdowns and release ~6 frames ahead
+    const float dt = m_lastStepNs ? float(nowNs - m_lastStepNs) / 1e9f : 0.0f;
+    m_moving = m_ballistics.step(dt);
+    m_lastStepNs = m_moving ? nowNs : 0;
+    m_targetsChanged = false;
+    ++m_steps;
+
+    ++m_revision;
+    ++m_notifications;
+    emit levelsChanged();
+}
+
+void MeterStore::clear()
+{
+    if (m_trackCount == 0)
+        return;
+    m_ballistics.reset();
+    m_ballistics.setChannelCount(0);
+    m_trackCount = 0;
+    m_moving = false;
+    m_targetsChanged = false;
+    m_lastStepNs = 0;
+    ++m_revision;
+    emit levelsChanged();
+}
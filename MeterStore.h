@@ -0,0 +1,75 @@
+#ifndef METERSTORE_H
+#define METERSTORE_H
+
+#include <QObject>
+
+#include "MeterBallistics.h"
+
+// ═══════════════════════════════════════════════════════════
+// METER STORE - Track levels outside the mixer model
+// ═══════════════════════════════════════════════════════════
+// Fed by CMD_TRACK_METERS at 30-60 Hz. Received levels are targets for
+// MeterBallistics; the displayed level, peak and clip latch come out of
+// one pass over all tracks per display frame (advanceFrame(), driven by
+// QQuickWindow::afterAnimating). Nothing goes through MixerModel.
+//
+// levelsChanged() fires once per stepped frame; QML bindings read
+// revision and then level()/peak()/clipped().
+class MeterStore : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int revision READ revision NOTIFY levelsChanged)
+    Q_PROPERTY(int trackCount READ trackCount NOTIFY levelsChanged)
+
+public:
+    static constexpr int MaxTracks = MeterBallistics::MaxChannels / 2;
+
+    explicit MeterStore(QObject *parent = nullptr);
+
+    int revision() const { return m_revision; }
+    // Highest track that has received a level, plus one
+    int trackCount() const { return m_trackCount; }
+
+    // 0.0 - 1.0; channel 0 = L, 1 = R
+    Q_INVOKABLE qreal level(int track, int channel) const;
+    Q_INVOKABLE qreal peak(int track, int channel) const;
+    // Latched until clearClips()/clearClip(), either channel
+    Q_INVOKABLE bool clipped(int track) const;
+    Q_INVOKABLE void clearClip(int track);
+    Q_INVOKABLE void clearClips();
+
+    // count (L, R) pairs of 7-bit levels starting at firstTrack
+    void setLevels7(int firstTrack, const quint8 *pairs, int count);
+    // One ballistics step per display frame; no-op while everything rests
+    void advanceFrame(qint64 nowNs);
+    void clear();
+
+    MeterBallistics &ballistics() { return m_ballistics; }
+
+    quint64 updates() const { return m_updates; }
+    quint64 notifications() const { return m_notifications; }
+    quint64 steps() const { return m_steps; }
+    void resetStatistics() { m_updates = 0; m_notifications = 0; m_steps = 0; }
+
+signals:
+    void levelsChanged();
+
+private slots:
+    void kick();
+
+private:
+    static bool validTrack(int track) { return track >= 0 && track < MaxTracks; }
+
+    MeterBallistics m_ballistics;
+    int m_trackCount = 0;
+    int m_revision = 0;
+    bool m_targetsChanged = false;   // new levels since the last step
+    bool m_moving = false;           // last step left something to animate
+    bool m_kickScheduled = false;
+    qint64 m_lastStepNs = 0;         // 0 while at rest
+    quint64 m_updates = 0;
+    quint64 m_notifications = 0;
+    quint64 m_steps = 0;
+};
+
+#endif // METERSTORE_H
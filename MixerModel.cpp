@@ -1,7 +1,29 @@
 #include "MixerModel.h"
-#include <cmath>
+#include "MixerValueTables.h"
+#include "PushCloneLogging.h"
 #include <QDebug>
 
+namespace {
+
+using RoleMask = ModelUpdateCoalescer::RoleMask;
+
+constexpr RoleMask role(int r)
+{
+    return ModelUpdateCoalescer::roleMask(r);
+}
+
+// Assigns and reports whether the stored value really changed
+template <typename T, typename V>
+bool assign(T &field, V &&value)
+{
+    if (field == value)
+        return false;
+    field = std::forward<V>(value);
+    return true;
+}
+
+} // namespace
+
 MixerModel::MixerModel(QObject *parent)
     : QAbstractListModel(parent)
 {
@@ -108,97 +130,153 @@ void MixerModel::setShowMasterReturns(bool show)
 void MixerModel::setTrackName(int trackIndex, const QString &name)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.name = name;
+        // Same name, same tag: skip building one
+        if (t.name == name)
+            return RoleMask(0);
+        RoleMask changed = 0;
+        if (assign(t.name, name))
+            changed |= role(NameRole);
         // Generate tag from name (first 3-4 chars, uppercase)
-        t.tag = name.left(4).toUpper();
+        if (assign(t.tag, name.left(4).toUpper()))
+            changed |= role(TagRole);
+        return changed;
     });
 }
 
 void MixerModel::setTrackColor(int trackIndex, const QColor &color)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.color = color;
+        return assign(t.color, color) ? role(ColorRole) : 0;
     });
 }
 
 void MixerModel::setTrackVolume(int trackIndex, float volume)
 {
-    qWarning() << "🎵🎵🎵 MixerModel::setTrackVolume CALLED: track=" << trackIndex << "volume=" << volume;
-    qWarning() << "   m_tracks.size()=" << m_tracks.size();
+    setTrackVolume14(trackIndex, MixerValueTables::fromNormalized(volume));
+}
 
-    updateTrack(trackIndex, [&](MixerTrack &t) {
-        qWarning() << "   Lambda executing: old volume=" << t.volume << "new volume=" << volume;
-        t.volume = qBound(0.0f, volume, 1.0f);
-        t.volumeLabel = formatVolumeLabel(t.volume);
-        qWarning() << "   Updated: volume=" << t.volume << "label=" << t.volumeLabel;
-    });
+void MixerModel::setTrackPan(int trackIndex, float pan)
+{
+    setTrackPan14(trackIndex, MixerValueTables::fromNormalized(pan));
+}
 
-    qWarning() << "   setTrackVolume completed";
+void MixerModel::setTrackSend(int trackIndex, int sendIndex, float value)
+{
+    setTrackSend14(trackIndex, sendIndex, MixerValueTables::fromNormalized(value));
 }
 
-void MixerModel::setTrackPan(int trackIndex, float pan)
+void MixerModel::setTrackVolume14(int trackIndex, quint16 value)
 {
-    updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.pan = qBound(0.0f, pan, 1.0f);
-        t.panLabel = formatPanLabel(t.pan);
+    const MixerValueTables &tables = MixerValueTables::instance();
+    updateTrack(trackIndex, [&](MixerTrack &t) -> RoleMask {
+        if (!assign(t.volume, tables.normalized(value)))
+            return 0;
+        RoleMask changed = role(VolumeRole);
+        if (assign(t.volumeLabel, tables.volumeLabel(value)))
+            changed |= role(VolumeLabelRole);
+        return changed;
     });
 }
 
-void MixerModel::setTrackSend(int trackIndex, int sendIndex, float value)
+void MixerModel::setTrackPan14(int trackIndex, quint16 value)
 {
-    updateTrack(trackIndex, [&](MixerTrack &t) {
-        value = qBound(0.0f, value, 1.0f);
+    const MixerValueTables &tables = MixerValueTables::instance();
+    updateTrack(trackIndex, [&](MixerTrack &t) -> RoleMask {
+        if (!assign(t.pan, tables.normalized(value)))
+            return 0;
+        RoleMask changed = role(PanRole);
+        if (assign(t.panLabel, tables.panLabel(value)))
+            changed |= role(PanLabelRole);
+        return changed;
+    });
+}
+
+void MixerModel::setTrackSend14(int trackIndex, int sendIndex, quint16 value)
+{
+    const float level = MixerValueTables::instance().normalized(value);
+    updateTrack(trackIndex, [&](MixerTrack &t) -> RoleMask {
         switch (sendIndex) {
-        case 0: t.sendA = value; break;
-        case 1: t.sendB = value; break;
-        case 2: t.sendC = value; break;
-        case 3: t.sendD = value; break;
+        case 0: return assign(t.sendA, level) ? role(SendARole) : 0;
+        case 1: return assign(t.sendB, level) ? role(SendBRole) : 0;
+        case 2: return assign(t.sendC, level) ? role(SendCRole) : 0;
+        case 3: return assign(t.sendD, level) ? role(SendDRole) : 0;
         }
+        return 0;
     });
 }
 
+void MixerModel::requestTrackVolume(int trackIndex, float volume)
+{
+    setTrackVolume(trackIndex, volume);
+    emit trackVolumeChangeRequested(trackIndex, qBound(0.0f, volume, 1.0f));
+}
+
+void MixerModel::requestTrackPan(int trackIndex, float pan)
+{
+    setTrackPan(trackIndex, pan);
+    emit trackPanChangeRequested(trackIndex, qBound(0.0f, pan, 1.0f));
+}
+
+void MixerModel::requestTrackSend(int trackIndex, int sendIndex, float value)
+{
+    setTrackSend(trackIndex, sendIndex, value);
+    emit trackSendChangeRequested(trackIndex, sendIndex, qBound(0.0f, value, 1.0f));
+}
+
+void MixerModel::releaseTrackParameter(int trackIndex, int parameter)
+{
+    emit trackParameterReleased(trackIndex, parameter);
+}
+
 void MixerModel::setTrackMuted(int trackIndex, bool muted)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.muted = muted;
+        return assign(t.muted, muted) ? role(MutedRole) : 0;
     });
 }
 
 void MixerModel::setTrackSolo(int trackIndex, bool solo)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.solo = solo;
+        return assign(t.solo, solo) ? role(SoloRole) : 0;
     });
 }
 
 void MixerModel::setTrackArmed(int trackIndex, bool armed)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.armed = armed;
+        return assign(t.armed, armed) ? role(ArmedRole) : 0;
     });
 }
 
 void MixerModel::setTrackActive(int trackIndex, bool active)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.active = active;
+        return assign(t.active, active) ? role(ActiveRole) : 0;
     });
 }
 
 void MixerModel::setTrackMeter(int trackIndex, float meterL, float meterR)
 {
     updateTrack(trackIndex, [&](MixerTrack &t) {
-        t.meterL = qBound(0.0f, meterL, 1.0f);
-        t.meterR = qBound(0.0f, meterR, 1.0f);
+        RoleMask changed = 0;
+        if (assign(t.meterL, qBound(0.0f, meterL, 1.0f)))
+            changed |= role(MeterLRole);
+        if (assign(t.meterR, qBound(0.0f, meterR, 1.0f)))
+            changed |= role(MeterRRole);
+        return changed;
     });
 }
 
 void MixerModel::resetAllTracks()
 {
+    const MixerValueTables &tables = MixerValueTables::instance();
+    const quint16 volume = MixerValueTables::fromNormalized(0.85f);
+    const quint16 pan = MixerValueTables::fromNormalized(0.5f);
     beginResetModel();
     for (auto &track : m_tracks) {
-        track.volume = 0.85f;
-        track.pan = 0.5f;
+        track.volume = tables.normalized(volume);
+        track.pan = tables.normalized(pan);
         track.sendA = 0.0f;
         track.sendB = 0.0f;
         track.sendC = 0.0f;
@@ -208,8 +286,8 @@ void MixerModel::resetAllTracks()
         track.armed = false;
         track.meterL = 0.0f;
         track.meterR = 0.0f;
-        track.volumeLabel = formatVolumeLabel(track.volume);
-        track.panLabel = formatPanLabel(track.pan);
+        track.volumeLabel = tables.volumeLabel(volume);
+        track.panLabel = tables.panLabel(pan);
     }
     endResetModel();
 }
@@ -258,53 +336,16 @@ int MixerModel::trackIndexFor(int trackIndex) const
     return trackIndex;
 }
 
-void MixerModel::updateTrack(int trackIndex, std::function<void(MixerTrack&)> updater)
+template <typename Updater>
+void MixerModel::updateTrack(int trackIndex, Updater &&updater)
 {
-    qWarning() << "📊📊📊 MixerModel::updateTrack: trackIndex=" << trackIndex << "m_tracks.size()=" << m_tracks.size();
-
     int idx = trackIndexFor(trackIndex);
-    qWarning() << "   trackIndexFor returned:" << idx;
-
     if (idx < 0) {
-        qWarning() << "   ❌ Invalid index, returning early";
+        PC_DEBUG(lcMixer) << "updateTrack: track" << trackIndex << "out of range (" << m_tracks.size() << ")";
         return;
     }
 
-    qWarning() << "   Calling updater lambda...";
-    updater(m_tracks[idx]);
-
-    const QModelIndex modelIndex = this->index(idx, 0);
-    qWarning() << "   Emitting dataChanged for row:" << idx;
-    emit dataChanged(modelIndex, modelIndex);
-    qWarning() << "   ✅ updateTrack completed";
-}
-
-QString MixerModel::formatVolumeLabel(float volume) const
-{
-    if (volume < 0.001f)
-        return "-∞";
-    
-    // Convert linear 0-1 to dB (approximation)
-    // 0.85 ≈ -1.5 dB, 1.0 = 0 dB
-    float db = 20.0f * std::log10(volume);
-    
-    if (db > -0.5f)
-        return QString("0.0 dB");
-    else if (db < -60.0f)
-        return "-∞";
-    else
-        return QString("%1 dB").arg(db, 0, 'f', 1);
-}
-
-QString MixerModel::formatPanLabel(float pan) const
-{
-    if (pan < 0.48f || pan > 0.52f) {
-        // Not center
-        int steps = static_cast<int>((pan - 0.5f) * 50.0f);  // -25 to +25
-        if (steps < 0)
-            return QString("L%1").arg(-steps);
-        else
-            return QString("R%1").arg(steps);
-    }
-    return "C";  // Center
+    const RoleMask changed = std::forward<Updater>(updater)(m_tracks[idx]);
+    if (changed)
+        ModelUpdateCoalescer::notify(m_coalescer, this, idx, idx, changed);
 }
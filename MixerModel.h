@@ -6,6 +6,10 @@
 #include <QVector>
 #include <QString>
 
+#include <utility>
+
+#include "ModelUpdateCoalescer.h"
+
 // ═══════════════════════════════════════════════════════════
 // MIXER TRACK STRUCTURE
 // ═══════════════════════════════════════════════════════════
@@ -75,6 +79,17 @@ public:
     };
     Q_ENUM(Roles)
 
+    // Outgoing continuous parameters (same order as MixerTxCoalescer)
+    enum Parameter {
+        VolumeParameter,
+        PanParameter,
+        SendAParameter,
+        SendBParameter,
+        SendCParameter,
+        SendDParameter
+    };
+    Q_ENUM(Parameter)
+
     explicit MixerModel(QObject *parent = nullptr);
 
     // QAbstractListModel interface
@@ -100,6 +115,11 @@ public:
     void setTrackVolume(int trackIndex, float volume);
     void setTrackPan(int trackIndex, float pan);
     void setTrackSend(int trackIndex, int sendIndex, float value);
+    // Raw 14-bit values from the wire; floats and labels come from
+    // MixerValueTables, nothing is formatted per update
+    void setTrackVolume14(int trackIndex, quint16 value);
+    void setTrackPan14(int trackIndex, quint16 value);
+    void setTrackSend14(int trackIndex, int sendIndex, quint16 value);
     void setTrackMuted(int trackIndex, bool muted);
     void setTrackSolo(int trackIndex, bool solo);
     void setTrackArmed(int trackIndex, bool armed);
@@ -110,10 +130,19 @@ public:
     void resetAllTracks();
     void setTotalTracks(int count);
 
+    // User gestures (touch faders): update locally and ask for the change.
+    // Call releaseTrackParameter() when the finger lifts.
+    Q_INVOKABLE void requestTrackVolume(int trackIndex, float volume);
+    Q_INVOKABLE void requestTrackPan(int trackIndex, float pan);
+    Q_INVOKABLE void requestTrackSend(int trackIndex, int sendIndex, float value);
+    Q_INVOKABLE void releaseTrackParameter(int trackIndex, int parameter);
+
     // Helpers
     Q_INVOKABLE int displayedTrackIndex(int localIndex) const;
     Q_INVOKABLE bool isValidTrack(int trackIndex) const;
 
+    void setCoalescer(ModelUpdateCoalescer *coalescer) { m_coalescer = coalescer; }
+
 signals:
     void trackBankChanged();
     void totalTracksChanged();
@@ -124,20 +153,23 @@ signals:
     void trackVolumeChangeRequested(int trackIndex, float volume);
     void trackPanChangeRequested(int trackIndex, float pan);
     void trackSendChangeRequested(int trackIndex, int sendIndex, float value);
+    void trackParameterReleased(int trackIndex, int parameter);
     void trackMuteToggleRequested(int trackIndex);
     void trackSoloToggleRequested(int trackIndex);
     void trackArmToggleRequested(int trackIndex);
 
 private:
     QVector<MixerTrack> m_tracks;
+    ModelUpdateCoalescer *m_coalescer = nullptr;
     int m_trackBank = 0;
     int m_selectedTrackIndex = 0;
     bool m_showMasterReturns = false;
 
     int trackIndexFor(int trackIndex) const;
-    void updateTrack(int trackIndex, std::function<void(MixerTrack&)> updater);
-    QString formatVolumeLabel(float volume) const;
-    QString formatPanLabel(float pan) const;
+    // updater returns the roles it really changed; nothing is emitted
+    // when it returns 0
+    template <typename Updater>
+    void updateTrack(int trackIndex, Updater &&updater);
 };
 
 #endif // MIXERMODEL_H
@@ -0,0 +1,70 @@
+#include "MixerTxCoalescer.h"
+
+const char *MixerTxCoalescer::parameterName(int parameter)
+{
+    switch (parameter) {
+    case Volume: return "volume";
+    case Pan: return "pan";
+    case SendA: return "sendA";
+    case SendB: return "sendB";
+    case SendC: return "sendC";
+    case SendD: return "sendD";
+    default: return "?";
+    }
+}
+
+bool MixerTxCoalescer::update(int track, int parameter, quint16 value)
+{
+    if (track < 0 || track >= MaxTracks || parameter < 0 || parameter >= ParameterCount)
+        return false;
+
+    ++m_counters[parameter].requested;
+    const int index = slotFor(track, parameter);
+    Slot &slot = m_slots[index];
+    slot.value = value;
+
+    // Back to what the Teensy already has: nothing to send
+    if (!slot.dirty && slot.everSent && slot.sentValue == value)
+        return true;
+
+    markDirty(index);
+    return true;
+}
+
+void MixerTxCoalescer::markFinal(int track, int parameter)
+{
+    if (track < 0 || track >= MaxTracks || parameter < 0 || parameter >= ParameterCount)
+        return;
+
+    const int index = slotFor(track, parameter);
+    Slot &slot = m_slots[index];
+    if (!slot.everSent && !slot.dirty)
+        return;   // never moved, nothing to confirm
+    slot.final = true;
+    markDirty(index);
+}
+
+void MixerTxCoalescer::markDirty(int slot)
+{
+    if (m_slots[slot].dirty)
+        return;
+    m_slots[slot].dirty = true;
+    m_dirty[m_dirtyCount++] = quint16(slot);
+}
+
+void MixerTxCoalescer::clear()
+{
+    for (int i = 0; i < m_dirtyCount; ++i) {
+        m_slots[m_dirty[i]].dirty = false;
+        m_slots[m_dirty[i]].final = false;
+    }
+    m_dirtyCount = 0;
+    // A new link starts from scratch: the next move is always sent
+    for (Slot &slot : m_slots)
+        slot.everSent = false;
+}
+
+void MixerTxCoalescer::resetStatistics()
+{
+    m_counters.fill(Counters());
+}
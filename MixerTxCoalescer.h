@@ -0,0 +1,99 @@
+#ifndef MIXERTXCOALESCER_H
+#define MIXERTXCOALESCER_H
+
+#include <QtGlobal>
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════
+// MIXER TX COALESCER - Last-value-wins slots for outgoing mixer moves
+// ═══════════════════════════════════════════════════════════
+// One slot per (track, parameter). A fader drag overwrites its slot as
+// often as the touch events come; flush() sends each dirty slot once, so
+// the wire sees at most one frame per slot per flush period. Dirty slots
+// are kept in a list in the order they were first touched, so a flush
+// never scans idle tracks.
+class MixerTxCoalescer
+{
+public:
+    // Same order as MixerModel::Parameter
+    enum Parameter {
+        Volume,
+        Pan,
+        SendA,
+        SendB,
+        SendC,
+        SendD,
+        ParameterCount
+    };
+
+    static constexpr int MaxTracks = 128;   // 7-bit track index on the wire
+
+    struct Counters {
+        quint64 requested = 0;   // values handed in
+        quint64 sent = 0;        // frames produced by flush()
+        quint64 finals = 0;      // release-triggered sends
+    };
+
+    static const char *parameterName(int parameter);
+
+    // Stores a 14-bit value; false if track/parameter is out of range
+    bool update(int track, int parameter, quint16 value);
+    // Gesture ended: the slot's last value is sent on the next flush even
+    // if it already went out, so the final position always reaches Live
+    void markFinal(int track, int parameter);
+
+    bool hasPending() const { return m_dirtyCount > 0; }
+    // Calls sink(track, parameter, value) for each dirty slot, oldest first
+    template <typename Sink>
+    int flush(Sink &&sink);
+    void clear();
+
+    const Counters &counters(int parameter) const { return m_counters[parameter]; }
+    void resetStatistics();
+
+private:
+    static constexpr int SlotCount = MaxTracks * ParameterCount;
+
+    struct Slot {
+        quint16 value = 0;
+        quint16 sentValue = 0;
+        bool dirty = false;
+        bool everSent = false;
+        bool final = false;
+    };
+
+    static int slotFor(int track, int parameter) { return track * ParameterCount + parameter; }
+    void markDirty(int slot);
+
+    std::array<Slot, SlotCount> m_slots {};
+    std::array<quint16, SlotCount> m_dirty {};
+    int m_dirtyCount = 0;
+    std::array<Counters, ParameterCount> m_counters {};
+};
+
+template <typename Sink>
+int MixerTxCoalescer::flush(Sink &&sink)
+{
+    const int count = m_dirtyCount;
+    m_dirtyCount = 0;
+
+    for (int i = 0; i < count; ++i) {
+        const int index = m_dirty[i];
+        Slot &slot = m_slots[index];
+        slot.dirty = false;
+
+        const int parameter = index % ParameterCount;
+        if (slot.final) {
+            slot.final = false;
+            ++m_counters[parameter].finals;
+        }
+        slot.sentValue = slot.value;
+        slot.everSent = true;
+        ++m_counters[parameter].sent;
+        sink(index / ParameterCount, parameter, slot.value);
+    }
+    return count;
+}
+
+#endif // MIXERTXCOALESCER_H
@@ -0,0 +1,64 @@
+#include "MixerValueTables.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+constexpr int PanSteps = 25;   // L25 .. C .. R25
+}
+
+const MixerValueTables &MixerValueTables::instance()
+{
+    static const MixerValueTables tables;
+    return tables;
+}
+
+MixerValueTables::MixerValueTables()
+{
+    // Volume: same rules the per-update formatter used. dB only grows with
+    // the value, so a new label starts whenever the 0.1 dB step changes.
+    const QString minusInf = QStringLiteral("-∞");
+    m_volumeLabels.reserve(640);
+    m_volumeLabels.append(minusInf);
+    m_volumeLabels.append(QStringLiteral("0.0 dB"));
+    int lastTenths = std::numeric_limits<int>::min();
+
+    for (int i = 0; i < Size; ++i) {
+        const float volume = float(i) / float(MaxValue);
+        m_normalized[i] = volume;
+        const float db = volume > 0.0f ? 20.0f * std::log10(volume)
+                                       : -std::numeric_limits<float>::infinity();
+        m_volumeDb[i] = db;
+
+        if (volume < 0.001f || db < -60.0f) {
+            m_volumeLabelIndex[i] = 0;
+        } else if (db > -0.5f) {
+            m_volumeLabelIndex[i] = 1;
+        } else {
+            const int tenths = int(std::lround(double(db) * 10.0));
+            if (tenths != lastTenths) {
+                lastTenths = tenths;
+                m_volumeLabels.append(QString::number(tenths / 10.0, 'f', 1) + QStringLiteral(" dB"));
+            }
+            m_volumeLabelIndex[i] = quint16(m_volumeLabels.size() - 1);
+        }
+    }
+
+    // Pan: 0.48-0.52 is centre, otherwise 2% per step
+    m_panLabels.reserve(2 * PanSteps + 1);
+    for (int steps = -PanSteps; steps <= PanSteps; ++steps) {
+        if (steps < 0)
+            m_panLabels.append(QStringLiteral("L%1").arg(-steps));
+        else if (steps > 0)
+            m_panLabels.append(QStringLiteral("R%1").arg(steps));
+        else
+            m_panLabels.append(QStringLiteral("C"));
+    }
+    for (int i = 0; i < Size; ++i) {
+        const float pan = m_normalized[i];
+        int steps = 0;
+        if (pan < 0.48f || pan > 0.52f)
+            steps = qBound(-PanSteps, int((pan - 0.5f) * 50.0f), PanSteps);
+        m_panLabelIndex[i] = quint8(steps + PanSteps);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef MIXERVALUETABLES_H
+#define MIXERVALUETABLES_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════
+// MIXER VALUE TABLES - 14-bit value → float, dB and label
+// ═══════════════════════════════════════════════════════════
+// Volume, pan and sends arrive as 14-bit values (0-16383), so every result
+// the mixer ever displays can be built once at startup: normalized float,
+// volume in dB, and an index into a small set of shared label strings
+// (523 distinct volume labels, 51 pan labels). Handing out a label is a
+// reference-count increment; nothing calls log10 or QString::arg per update.
+//
+// Built on first use (thread-safe static), ~180 KB.
+class MixerValueTables
+{
+public:
+    static constexpr int Size = 1 << 14;
+    static constexpr quint16 MaxValue = Size - 1;
+
+    static const MixerValueTables &instance();
+
+    // Nearest 14-bit value, clamped; what the TX path sends for a float
+    static quint16 fromNormalized(float value)
+    {
+        return quint16(qRound(qBound(0.0f, value, 1.0f) * float(MaxValue)));
+    }
+
+    float normalized(quint16 value) const { return m_normalized[clamp(value)]; }
+    // -inf for silence
+    float volumeDb(quint16 value) const { return m_volumeDb[clamp(value)]; }
+    const QString &volumeLabel(quint16 value) const { return m_volumeLabels[m_volumeLabelIndex[clamp(value)]]; }
+    const QString &panLabel(quint16 value) const { return m_panLabels[m_panLabelIndex[clamp(value)]]; }
+
+    int volumeLabelCount() const { return m_volumeLabels.size(); }
+    int panLabelCount() const { return m_panLabels.size(); }
+
+private:
+    MixerValueTables();
+    static int clamp(quint16 value) { return qMin<int>(value, MaxValue); }
+
+    std::array<float, Size> m_normalized;
+    std::array<float, Size> m_volumeDb;
+    std::array<quint16, Size> m_volumeLabelIndex;
+    std::array<quint8, Size> m_panLabelIndex;
+    QVector<QString> m_volumeLabels;
+    QVector<QString> m_panLabels;
+};
+
+#endif // MIXERVALUETABLES_H
@@ -0,0 +1,208 @@
+#include "ModelUpdateCoalescer.h"
+
+ModelUpdateCoalescer::ModelUpdateCoalescer(QObject *parent)
+    : QObject(parent)
+{
+    m_fallbackTimer.setSingleShot(true);
+    m_fallbackTimer.setInterval(FallbackFlushMs);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &ModelUpdateCoalescer::fallbackFlush);
+}
+
+void ModelUpdateCoalescer::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+    if (!enabled)
+        flush();
+    m_enabled = enabled;
+}
+
+void ModelUpdateCoalescer::addModel(QAbstractItemModel *model, const QString &name)
+{
+    if (!model || entryFor(model))
+        return;
+    Entry entry;
+    entry.model = model;
+    entry.name = name;
+    m_entries.append(entry);
+}
+
+ModelUpdateCoalescer::Entry *ModelUpdateCoalescer::entryFor(QAbstractItemModel *model)
+{
+    for (Entry &entry : m_entries) {
+        if (entry.model == model)
+            return &entry;
+    }
+    return nullptr;
+}
+
+void ModelUpdateCoalescer::notify(ModelUpdateCoalescer *coalescer, QAbstractItemModel *model,
+                                  int first, int last, RoleMask roles)
+{
+    if (coalescer) {
+        coalescer->markDirty(model, first, last, roles);
+        return;
+    }
+    emit model->dataChanged(model->index(first, 0), model->index(last, 0), rolesFor(roles));
+}
+
+void ModelUpdateCoalescer::markDirty(QAbstractItemModel *model, int first, int last, RoleMask roles)
+{
+    if (first > last || first < 0 || roles == 0)
+        return;
+
+    Entry *entry = entryFor(model);
+    if (!entry || !m_enabled) {
+        if (entry) {
+            ++entry->marks;
+            emitRows(*entry, first, last, roles);
+        } else {
+            emit model->dataChanged(model->index(first, 0), model->index(last, 0), rolesFor(roles));
+        }
+        return;
+    }
+
+    ++m_marks;
+    ++entry->marks;
+    if (last >= entry->rows.size())
+        entry->rows.resize(last + 1);
+    for (int row = first; row <= last; ++row)
+        entry->rows[row] |= roles;
+    entry->firstDirty = entry->lastDirty < 0 ? first : qMin(entry->firstDirty, first);
+    entry->lastDirty = qMax(entry->lastDirty, last);
+    emit changeRecorded();
+
+    if (!m_pending) {
+        m_pending = true;
+        m_fallbackTimer.start();
+        emit frameRequested();
+    }
+}
+
+void ModelUpdateCoalescer::flush()
+{
+    if (!m_pending)
+        return;
+    m_pending = false;
+    m_fallbackTimer.stop();
+
+    const quint64 before = m_emissions;
+    for (Entry &entry : m_entries) {
+        if (entry.lastDirty < 0)
+            continue;
+        const int firstDirty = entry.firstDirty;
+        const int lastDirty = entry.lastDirty;
+        entry.firstDirty = -1;
+        entry.lastDirty = -1;
+
+        // Rows removed since they were marked are simply dropped
+        const int last = qMin(lastDirty, entry.model->rowCount() - 1);
+        int row = firstDirty;
+        while (row <= last) {
+            if (!entry.rows[row]) {
+                ++row;
+                continue;
+            }
+            const int first = row;
+            RoleMask roles = 0;
+            while (row <= last && entry.rows[row]) {
+                roles |= entry.rows[row];
+                entry.rows[row++] = 0;
+            }
+            emitRows(entry, first, row - 1, roles);
+        }
+        for (row = qMax(firstDirty, last + 1); row <= lastDirty; ++row)
+            entry.rows[row] = 0;
+    }
+
+    ++m_frames;
+    m_lastFrameEmissions = m_emissions - before;
+    m_frameEmissions += m_lastFrameEmissions;
+    m_maxFrameEmissions = qMax(m_maxFrameEmissions, m_lastFrameEmissions);
+}
+
+void ModelUpdateCoalescer::fallbackFlush()
+{
+    // No frame rendered in time (window hidden or minimised)
+    if (!m_pending)
+        return;
+    ++m_fallbackFlushes;
+    flush();
+}
+
+void ModelUpdateCoalescer::emitRows(Entry &entry, int first, int last, RoleMask roles)
+{
+    ++entry.emissions;
+    ++m_emissions;
+    QAbstractItemModel *model = entry.model;
+    emit model->dataChanged(model->index(first, 0), model->index(last, 0), rolesFor(roles));
+}
+
+ModelUpdateCoalescer::RoleMask ModelUpdateCoalescer::roleMask(std::initializer_list<int> roles)
+{
+    if (roles.size() == 0)
+        return AllRoles;
+    RoleMask mask = 0;
+    for (int role : roles)
+        mask |= roleMask(role);
+    return mask;
+}
+
+ModelUpdateCoalescer::RoleMask ModelUpdateCoalescer::roleMask(const QVector<int> &roles)
+{
+    if (roles.isEmpty())
+        return AllRoles;
+    RoleMask mask = 0;
+    for (int role : roles)
+        mask |= roleMask(role);
+    return mask;
+}
+
+QVector<int> ModelUpdateCoalescer::rolesFor(RoleMask mask)
+{
+    QVector<int> roles;
+    if (mask == AllRoles)
+        return roles;
+    for (RoleMask bits = mask; bits; bits &= bits - 1)
+        roles.append(Qt::UserRole + 1 + int(qCountTrailingZeroBits(bits)));
+    return roles;
+}
+
+QVariantMap ModelUpdateCoalescer::statistics() const
+{
+    QVariantMap models;
+    for (const Entry &entry : m_entries) {
+        QVariantMap values;
+        values.insert(QStringLiteral("marks"), entry.marks);
+        values.insert(QStringLiteral("emissions"), entry.emissions);
+        models.insert(entry.name, values);
+    }
+
+    QVariantMap stats;
+    stats.insert(QStringLiteral("enabled"), m_enabled);
+    stats.insert(QStringLiteral("frames"), m_frames);
+    stats.insert(QStringLiteral("marks"), m_marks);
+    stats.insert(QStringLiteral("emissions"), m_emissions);
+    stats.insert(QStringLiteral("emissionsPerFrameAvg"),
+                 m_frames ? double(m_frameEmissions) / double(m_frames) : 0.0);
+    stats.insert(QStringLiteral("lastFrameEmissions"), m_lastFrameEmissions);
+    stats.insert(QStringLiteral("maxFrameEmissions"), m_maxFrameEmissions);
+    stats.insert(QStringLiteral("fallbackFlushes"), m_fallbackFlushes);
+    stats.insert(QStringLiteral("models"), models);
+    return stats;
+}
+
+void ModelUpdateCoalescer::resetStatistics()
+{
+    for (Entry &entry : m_entries) {
+        entry.marks = 0;
+        entry.emissions = 0;
+    }
+    m_frames = 0;
+    m_marks = 0;
+    m_emissions = 0;
+    m_frameEmissions = 0;
+    m_lastFrameEmissions = 0;
+    m_maxFrameEmissions = 0;
+    m_fallbackFlushes = 0;
+}
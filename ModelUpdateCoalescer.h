@@ -0,0 +1,103 @@
+#ifndef MODELUPDATECOALESCER_H
+#define MODELUPDATECOALESCER_H
+
+#include <QObject>
+#include <QAbstractItemModel>
+#include <QString>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+
+#include <initializer_list>
+
+// ═══════════════════════════════════════════════════════════
+// MODEL UPDATE COALESCER - One dataChanged flush per display frame
+// ═══════════════════════════════════════════════════════════
+// A burst from the Teensy (ring move, bulk metadata, mixer state) touches
+// clips, tracks, scenes and mixer in one handleReadyRead. Instead of each
+// setter emitting dataChanged, the models record dirty rows and roles
+// here; flush() runs from QQuickWindow::afterAnimating, right before the
+// scene graph syncs, and emits one dataChanged per run of consecutive
+// dirty rows per model with the union of their roles.
+//
+// Disabled (the default, and always for headless use: benchmarks, tools)
+// notify() emits immediately. main.cpp enables it once a window drives
+// flush(); frameRequested() asks that window for a frame when idle, and a
+// fallback timer flushes if no frame comes (window hidden).
+class ModelUpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Bit n = role Qt::UserRole + 1 + n. AllRoles = dataChanged without roles.
+    using RoleMask = quint32;
+    static constexpr RoleMask AllRoles = ~RoleMask(0);
+    static constexpr int FallbackFlushMs = 50;
+
+    explicit ModelUpdateCoalescer(QObject *parent = nullptr);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // name is only used for the statistics
+    void addModel(QAbstractItemModel *model, const QString &name);
+
+    // What the models call instead of emitting dataChanged themselves;
+    // coalescer may be null (model used on its own)
+    static void notify(ModelUpdateCoalescer *coalescer, QAbstractItemModel *model,
+                       int first, int last, RoleMask roles);
+    void markDirty(QAbstractItemModel *model, int first, int last, RoleMask roles);
+    bool hasPending() const { return m_pending; }
+    void flush();
+
+    static constexpr RoleMask roleMask(int role)
+    {
+        return role > Qt::UserRole && role <= Qt::UserRole + 32
+                   ? RoleMask(1) << (role - Qt::UserRole - 1)
+                   : AllRoles;
+    }
+    static RoleMask roleMask(std::initializer_list<int> roles);
+    static RoleMask roleMask(const QVector<int> &roles);
+    static QVector<int> rolesFor(RoleMask mask);
+
+    // { frames, marks, emissions, lastFrameEmissions, maxFrameEmissions,
+    //   fallbackFlushes, models: { <name>: { marks, emissions } } }
+    QVariantMap statistics() const;
+    void resetStatistics();
+
+signals:
+    // Something is pending: the window should render a frame
+    void frameRequested();
+    // Every recorded change, while deferred (latency tracing)
+    void changeRecorded();
+
+private:
+    struct Entry {
+        QAbstractItemModel *model = nullptr;
+        QString name;
+        QVector<RoleMask> rows;
+        int firstDirty = -1;
+        int lastDirty = -1;
+        quint64 marks = 0;
+        quint64 emissions = 0;
+    };
+
+    Entry *entryFor(QAbstractItemModel *model);
+    void emitRows(Entry &entry, int first, int last, RoleMask roles);
+    void fallbackFlush();
+
+    QVector<Entry> m_entries;   // a handful of models: linear lookup
+    QTimer m_fallbackTimer;
+    bool m_enabled = false;
+    bool m_pending = false;
+
+    quint64 m_frames = 0;
+    quint64 m_marks = 0;
+    quint64 m_emissions = 0;
+    quint64 m_frameEmissions = 0;     // emitted from flush() only
+    quint64 m_lastFrameEmissions = 0;
+    quint64 m_maxFrameEmissions = 0;
+    quint64 m_fallbackFlushes = 0;
+};
+
+#endif // MODELUPDATECOALESCER_H
@@ -0,0 +1,19 @@
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <QtGlobal>
+
+#include <chrono>
+
+// Process-wide monotonic timestamps in nanoseconds, comparable across threads.
+namespace MonotonicClock {
+
+inline qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace MonotonicClock
+
+#endif // MONOTONICCLOCK_H
@@ -0,0 +1,155 @@
+#include "NamePool.h"
+#include "PushCloneLogging.h"
+
+namespace {
+constexpr int InitialSlots = 256;
+
+// FNV-1a over the (masked) bytes
+template <quint8 Mask>
+quint32 hashBytes(const quint8 *data, int len)
+{
+    quint32 h = 2166136261u;
+    for (int i = 0; i < len; ++i) {
+        h ^= quint32(data[i] & Mask);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+template <quint8 Mask>
+bool sameBytes(const QByteArray &stored, const quint8 *data, int len)
+{
+    if (stored.size() != len)
+        return false;
+    const quint8 *s = reinterpret_cast<const quint8 *>(stored.constData());
+    for (int i = 0; i < len; ++i) {
+        if (s[i] != (data[i] & Mask))
+            return false;
+    }
+    return true;
+}
+}
+
+NamePool &NamePool::instance()
+{
+    static NamePool pool;
+    return pool;
+}
+
+NamePool::NamePool()
+{
+    m_entries.reserve(InitialSlots / 2);
+    m_entries.append(Entry());   // Handle 0
+    m_slots = QVector<Handle>(InitialSlots, Empty);
+}
+
+NamePool::Handle NamePool::intern(const char *utf8, int len)
+{
+    return lookup<0xFF>(reinterpret_cast<const quint8 *>(utf8), len);
+}
+
+NamePool::Handle NamePool::intern7bit(const quint8 *data, int len)
+{
+    return lookup<0x7F>(data, len);
+}
+
+NamePool::Handle NamePool::intern(const QString &name)
+{
+    if (name.isEmpty())
+        return Empty;
+    const QByteArray utf8 = name.toUtf8();
+    return intern(utf8.constData(), int(utf8.size()));
+}
+
+template <quint8 Mask>
+NamePool::Handle NamePool::lookup(const quint8 *data, int len)
+{
+    if (len <= 0)
+        return Empty;
+    ++m_lookups;
+
+    const quint32 hash = hashBytes<Mask>(data, len);
+    const int mask = m_slots.size() - 1;
+    int slot = int(hash) & mask;
+    while (const Handle handle = m_slots[slot]) {
+        const Entry &entry = m_entries[int(handle)];
+        if (entry.hash == hash && sameBytes<Mask>(entry.utf8, data, len))
+            return handle;
+        slot = (slot + 1) & mask;
+    }
+
+    if (m_free.isEmpty() && m_entries.size() >= MaxNames) {
+        if (m_rejected++ == 0)
+            PC_WARN(lcSession) << "Name pool full (" << MaxNames << "names); new names read as empty";
+        return Empty;
+    }
+
+    Entry entry;
+    entry.utf8.resize(len);
+    char *out = entry.utf8.data();
+    for (int i = 0; i < len; ++i)
+        out[i] = char(data[i] & Mask);
+    entry.text = QString::fromUtf8(entry.utf8);
+    entry.hash = hash;
+
+    Handle handle;
+    if (!m_free.isEmpty()) {
+        handle = m_free.last();
+        m_free.removeLast();
+        m_entries[int(handle)] = entry;
+    } else {
+        handle = Handle(m_entries.size());
+        m_entries.append(entry);
+    }
+    m_slots[slot] = handle;
+    ++m_inserts;
+    ++m_insertsSinceSweep;
+
+    // Keep the load factor under one half
+    if (m_entries.size() * 2 > m_slots.size())
+        rehash(m_slots.size() * 2);
+    return handle;
+}
+
+void NamePool::beginSweep()
+{
+    m_marks = QVector<quint8>(m_entries.size(), 0);
+}
+
+int NamePool::sweep()
+{
+    int freed = 0;
+    for (int i = 1; i < m_entries.size(); ++i) {
+        Entry &entry = m_entries[i];
+        // Interned after beginSweep() counts as held
+        if (entry.utf8.isEmpty() || i >= m_marks.size() || m_marks[i])
+            continue;
+        entry = Entry();
+        m_free.append(Handle(i));
+        ++freed;
+    }
+    m_marks = QVector<quint8>();
+    // Freed entries must not be found again: rebuild the table without them
+    rehash(m_slots.size());
+
+    m_reclaimed += quint64(freed);
+    m_insertsSinceSweep = 0;
+    // Mostly held names: wait for the pool to double before trying again
+    m_sweepAt = qMin(MaxNames, qMax(int(SweepAt), size() * 2));
+    return freed;
+}
+
+void NamePool::rehash(int tableSize)
+{
+    QVector<Handle> table(tableSize, Empty);
+    const int mask = table.size() - 1;
+    for (int i = 1; i < m_entries.size(); ++i) {
+        if (m_entries[i].utf8.isEmpty())
+            continue;
+        int slot = int(m_entries[i].hash) & mask;
+        while (table[slot])
+            slot = (slot + 1) & mask;
+        table[slot] = Handle(i);
+    }
+    m_slots.swap(table);
+}
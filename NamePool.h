@@ -0,0 +1,89 @@
+#ifndef NAMEPOOL_H
+#define NAMEPOOL_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// ═══════════════════════════════════════════════════════════
+// NAME POOL - Interned clip, track and scene names
+// ═══════════════════════════════════════════════════════════
+// A Live set repeats the same few names ("Audio", "MIDI", "Drums", ...)
+// on every ring move. Names are looked up straight from the payload bytes
+// (hash + compare, no QString built) and come back as a small handle, so
+// models and the session cache compare integers and a name seen before
+// costs no allocation. The QString behind a handle is shared: handing it
+// to QML is a reference-count increment.
+//
+// Names nobody holds any more are reclaimed by mark and sweep: every
+// holder (models, session cache) marks its handles between beginSweep()
+// and sweep(), the rest are freed and their handles reused. A holder that
+// doesn't mark would later read someone else's name. GUI thread only.
+class NamePool
+{
+public:
+    using Handle = quint32;
+    static constexpr Handle Empty = 0;            // always the empty string
+    // More than the session cache and models can hold at once, so a sweep
+    // always makes room; past this, new names read as empty
+    static constexpr int MaxNames = 1 << 18;
+    static constexpr int SweepAt = 1 << 16;       // first high-water mark
+
+    static NamePool &instance();
+
+    // UTF-8 bytes as they arrive on the wire
+    Handle intern(const char *utf8, int len);
+    // Bulk metadata names: 7-bit characters, top bit ignored
+    Handle intern7bit(const quint8 *data, int len);
+    // Names built locally ("Scene 5"); converts to UTF-8 first
+    Handle intern(const QString &name);
+
+    const QString &name(Handle handle) const
+    {
+        return handle < Handle(m_entries.size()) ? m_entries[int(handle)].text : m_entries[0].text;
+    }
+
+    // Reclaiming
+    bool wantsSweep() const { return size() >= m_sweepAt; }
+    int insertsSinceSweep() const { return m_insertsSinceSweep; }
+    void beginSweep();
+    void mark(Handle handle)
+    {
+        if (handle < Handle(m_marks.size()))
+            m_marks[int(handle)] = 1;
+    }
+    int sweep();   // returns the number of names freed
+
+    int size() const { return m_entries.size() - m_free.size(); }
+    quint64 lookups() const { return m_lookups; }
+    quint64 inserts() const { return m_inserts; }
+    quint64 rejected() const { return m_rejected; }
+    quint64 reclaimed() const { return m_reclaimed; }
+
+private:
+    NamePool();
+
+    struct Entry {
+        QByteArray utf8;          // empty = free (handle on m_free)
+        QString text;
+        quint32 hash = 0;
+    };
+
+    template <quint8 Mask>
+    Handle lookup(const quint8 *data, int len);
+    void rehash(int tableSize);
+
+    QVector<Entry> m_entries;
+    QVector<Handle> m_slots;      // open addressing, 0 = free (Empty is never stored)
+    QVector<Handle> m_free;       // freed by sweep(), reused first
+    QVector<quint8> m_marks;      // per handle, between beginSweep() and sweep()
+    int m_sweepAt = SweepAt;
+    int m_insertsSinceSweep = 0;
+    quint64 m_lookups = 0;
+    quint64 m_inserts = 0;
+    quint64 m_rejected = 0;
+    quint64 m_reclaimed = 0;
+};
+
+#endif // NAMEPOOL_H
@@ -0,0 +1,470 @@
+#ifndef PROTOCOLSCHEMA_H
+#define PROTOCOLSCHEMA_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QColor>
+#include <QString>
+
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+#include "SerialFrameParser.h"
+
+// ═══════════════════════════════════════════════════════════
+// PUSHCLONE SERIAL PROTOCOL - Compile-time schema
+// ═══════════════════════════════════════════════════════════
+// Every command lists its ID, accepted payload length and field layout.
+// Command<>::decode() turns a validated PayloadView into a std::tuple of
+// typed fields, so handlers never index raw bytes themselves.
+namespace Protocol {
+
+enum Cmd : quint8 {
+    CmdHandshake = 0x00,
+    CmdHandshakeReply = 0x01,
+    CmdDisconnect = 0x02,
+    CmdPing = 0x03,
+    CmdLinkCheck = 0x04,     // both ways, first frames after a baud switch
+    CmdSelectedTrack = 0x06,
+    CmdGridUpdate7bit = 0x60,
+    CmdGridUpdate14bit = 0xA6, // CmdLedGridUpdate14
+    CmdPadUpdate7bit = 0x84,   // CmdLedRgbState
+    CmdPadUpdate14bit = 0xA7,  // CmdLedPadUpdate14
+    CmdGridDelta14bit = 0xA8,  // dirty mask + Rgb14 for the changed pads only
+    CmdClipTrigger = 0x11,
+    CmdClipName = 0x14,
+    CmdClipState = 0x10,
+    CmdTrackName = 0x27,
+    CmdTrackColor = 0x28,
+    CmdSceneName = 0x1B,
+    CmdSceneColor = 0x1C,
+    CmdSceneState = 0x1A,
+    CmdSceneTriggered = 0x1D,
+    CmdTransportPlay = 0x40,
+    CmdTransportRecord = 0x41,
+    CmdTransportLoop = 0x42,
+    CmdTransportTempo = 0x43,
+    CmdTransportPosition = 0x45,
+    CmdTransportState = 0x49,
+    CmdShiftState = 0x88,
+    CmdRingPosition = 0x0C,  // Session ring position update
+    // Mixer commands
+    CmdMixerVolume = 0x21,
+    CmdMixerPan = 0x22,
+    CmdMixerMute = 0x23,
+    CmdMixerSolo = 0x24,
+    CmdMixerArm = 0x25,
+    CmdMixerSend = 0x26,
+    CmdTrackMeters = 0xA9,     // [first track] + N × (L, R) 7-bit levels
+    CmdTrackSelect = 0x0D,     // GUI → Teensy → Live: select track
+    CmdMixerMode = 0x98,
+    CmdMixerBankChange = 0x99,  // GUI → Teensy: notify bank change for fader pickup
+    CmdSessionRingMetadata = 0x9A,  // Bulk session ring metadata (tracks/scenes names+colors)
+    CmdSessionRingClips = 0x9B,     // Bulk session ring clips (32 clips states+colors)
+    CmdRingPrefetch = 0xAB,         // GUI → Teensy: [track14, scene14] send that 8x4 window
+    CmdPrefetchMetadata = 0xAC,     // [track14, scene14] + SESSION_RING_METADATA body
+    CmdPrefetchClips = 0xAD         // [track14, scene14] + SESSION_RING_CLIPS body
+};
+
+constexpr int MaxLen = SerialFrameParser::MaxPayload;
+
+// Wire names, for logs and the trace decoder
+inline const char *commandName(quint8 cmd)
+{
+    switch (cmd) {
+    case CmdHandshake: return "HANDSHAKE";
+    case CmdHandshakeReply: return "HANDSHAKE_REPLY";
+    case CmdDisconnect: return "DISCONNECT";
+    case CmdPing: return "PING";
+    case CmdLinkCheck: return "LINK_CHECK";
+    case CmdSelectedTrack: return "SELECTED_TRACK";
+    case CmdGridUpdate7bit: return "GRID_UPDATE_7";
+    case CmdGridUpdate14bit: return "GRID_UPDATE_14";
+    case CmdPadUpdate7bit: return "PAD_UPDATE_7";
+    case CmdPadUpdate14bit: return "PAD_UPDATE_14";
+    case CmdGridDelta14bit: return "GRID_DELTA_14";
+    case CmdTrackMeters: return "TRACK_METERS";
+    case CmdClipTrigger: return "CLIP_TRIGGER";
+    case CmdClipName: return "CLIP_NAME";
+    case CmdClipState: return "CLIP_STATE";
+    case CmdTrackName: return "TRACK_NAME";
+    case CmdTrackColor: return "TRACK_COLOR";
+    case CmdSceneName: return "SCENE_NAME";
+    case CmdSceneColor: return "SCENE_COLOR";
+    case CmdSceneState: return "SCENE_STATE";
+    case CmdSceneTriggered: return "SCENE_TRIGGERED";
+    case CmdTransportPlay: return "TRANSPORT_PLAY";
+    case CmdTransportRecord: return "TRANSPORT_RECORD";
+    case CmdTransportLoop: return "TRANSPORT_LOOP";
+    case CmdTransportTempo: return "TRANSPORT_TEMPO";
+    case CmdTransportPosition: return "TRANSPORT_POSITION";
+    case CmdTransportState: return "TRANSPORT_STATE";
+    case CmdShiftState: return "SHIFT_STATE";
+    case CmdRingPosition: return "RING_POSITION";
+    case CmdMixerVolume: return "MIXER_VOLUME";
+    case CmdMixerPan: return "MIXER_PAN";
+    case CmdMixerMute: return "MIXER_MUTE";
+    case CmdMixerSolo: return "MIXER_SOLO";
+    case CmdMixerArm: return "MIXER_ARM";
+    case CmdMixerSend: return "MIXER_SEND";
+    case CmdTrackSelect: return "TRACK_SELECT";
+    case CmdMixerMode: return "MIXER_MODE";
+    case CmdMixerBankChange: return "MIXER_BANK_CHANGE";
+    case CmdSessionRingMetadata: return "SESSION_RING_METADATA";
+    case CmdSessionRingClips: return "SESSION_RING_CLIPS";
+    case CmdRingPrefetch: return "RING_PREFETCH";
+    case CmdPrefetchMetadata: return "PREFETCH_METADATA";
+    case CmdPrefetchClips: return "PREFETCH_CLIPS";
+    default: return nullptr;
+    }
+}
+
+// ───────────────────────────────────────────────────────────
+// Value helpers
+// ───────────────────────────────────────────────────────────
+inline int decode14Bit(quint8 msb, quint8 lsb)
+{
+    return ((msb & 0x7F) << 7) | (lsb & 0x7F);
+}
+
+inline int normalize14To8(quint8 msb, quint8 lsb)
+{
+    // Colors are packed as two 7-bit MIDI-safe bytes that together represent
+    // the original 0-255 component. Just reconstruct and clamp.
+    return qBound(0, decode14Bit(msb, lsb), 255);
+}
+
+inline int normalize7To8(quint8 value)
+{
+    return static_cast<int>(((value & 0x7F) * 255) / 127);
+}
+
+inline QRgb rgbFrom14(const quint8 *data)
+{
+    return qRgb(normalize14To8(data[0], data[1]),
+                normalize14To8(data[2], data[3]),
+                normalize14To8(data[4], data[5]));
+}
+
+inline QRgb rgbFrom7(const quint8 *data)
+{
+    return qRgb(normalize7To8(data[0]),
+                normalize7To8(data[1]),
+                normalize7To8(data[2]));
+}
+
+inline QColor colorFrom14(const quint8 *data)
+{
+    return QColor(rgbFrom14(data));
+}
+
+inline QColor colorFrom7(const quint8 *data)
+{
+    return QColor(rgbFrom7(data));
+}
+
+// 32-bit pad mask as five 7-bit bytes, bit 0 first (pad = scene * 8 + track)
+constexpr int Mask32Size = 5;
+
+inline quint32 decodeMask32(const quint8 *data)
+{
+    return quint32(data[0] & 0x7F)
+        | quint32(data[1] & 0x7F) << 7
+        | quint32(data[2] & 0x7F) << 14
+        | quint32(data[3] & 0x7F) << 21
+        | quint32(data[4] & 0x0F) << 28;
+}
+
+inline void encodeMask32(quint32 mask, quint8 *out)
+{
+    for (int i = 0; i < Mask32Size; ++i)
+        out[i] = quint8((mask >> (7 * i)) & 0x7F);
+}
+
+// The UTF-8 bytes of a length-prefixed string, without decoding them
+inline PayloadView lengthPrefixedBytes(const PayloadView &payload, int offset)
+{
+    if (offset >= payload.size())
+        return PayloadView();
+
+    const int remaining = payload.size() - offset;
+    if (remaining <= 0)
+        return PayloadView();
+
+    const quint8 declaredLen = payload.at(offset);
+    const int available = remaining - 1;
+    if (declaredLen > 0 && available >= declaredLen)
+        return PayloadView(payload.data() + offset + 1, declaredLen);
+
+    if (available <= 0)
+        return PayloadView();
+
+    // Fallback: treat the rest as a raw UTF-8 string (legacy packets)
+    return PayloadView(payload.data() + offset, remaining);
+}
+
+// ───────────────────────────────────────────────────────────
+// Handshake capabilities
+// ───────────────────────────────────────────────────────────
+// CMD_HANDSHAKE (Teensy) and CMD_HANDSHAKE_REPLY (GUI) payloads:
+//   "PUSHCLONE_GUI"                                   v1-only firmware
+//   "PUSHCLONE_GUI" [framing]                         + framing offer
+//   "PUSHCLONE_GUI" [framing] [features:14] [maxPayload:14] [baud:28]
+// The reply mirrors the form it was offered, carrying the agreed values:
+// min framing, common features, the GUI's own max payload and the baud
+// rate to switch to (0 = stay at the current rate).
+//
+// Baud switch: both sides change rate once the reply is on the wire (the
+// GUI waits BaudSwitchDelayMs). The firmware then repeats CMD_LINK_CHECK
+// at the new rate until the GUI echoes it; if no check gets through
+// within LinkCheckTimeoutMs both sides return to the base rate and
+// framing v1, and the GUI stops offering a switch on that port.
+enum Feature : quint16 {
+    FeatureGridDelta = 1 << 0,   // CMD_GRID_DELTA_14
+    FeaturePingEcho = 1 << 1,    // CMD_PING payloads echoed verbatim (GUI RTT probes)
+    FeatureTrackMeters = 1 << 2, // CMD_TRACK_METERS; firmware streams meters only if agreed
+    FeatureRingPrefetch = 1 << 3, // CMD_RING_PREFETCH answered with PREFETCH_METADATA/_CLIPS
+};
+
+constexpr int BaudSwitchDelayMs = 20;
+constexpr int LinkCheckTimeoutMs = 1000;
+
+inline const QByteArray &handshakeMagic()
+{
+    static const QByteArray magic = QByteArrayLiteral("PUSHCLONE_GUI");
+    return magic;
+}
+
+struct LinkCaps
+{
+    enum Form { MagicOnly, WithFraming, Full };
+    static constexpr int FullSize = 1 + 2 + 2 + 4;
+
+    Form form = MagicOnly;
+    quint8 framing = 1;
+    quint16 features = 0;
+    quint16 maxPayload = 255;
+    quint32 baudRate = 0;
+
+    // Payload must start with the magic; false for anything else
+    static bool decode(const PayloadView &payload, LinkCaps *caps)
+    {
+        const QByteArray &magic = handshakeMagic();
+        const int at = int(magic.size());
+        if (payload.size() < at || std::memcmp(payload.constData(), magic.constData(), size_t(at)) != 0)
+            return false;
+
+        const quint8 *p = payload.data() + at;
+        switch (payload.size() - at) {
+        case 0:
+            caps->form = MagicOnly;
+            return true;
+        case 1:
+            caps->form = WithFraming;
+            caps->framing = p[0];
+            return true;
+        case FullSize:
+            caps->form = Full;
+            caps->framing = p[0];
+            caps->features = quint16(decode14Bit(p[1], p[2]));
+            caps->maxPayload = quint16(decode14Bit(p[3], p[4]));
+            caps->baudRate = quint32(decode14Bit(p[5], p[6])) << 14 | quint32(decode14Bit(p[7], p[8]));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    QByteArray encode() const
+    {
+        QByteArray out = handshakeMagic();
+        if (form == MagicOnly)
+            return out;
+        out.append(char(framing));
+        if (form == WithFraming)
+            return out;
+        const quint32 values[] = { features, maxPayload, (baudRate >> 14) & 0x3FFF, baudRate & 0x3FFF };
+        for (quint32 value : values)
+            out.append(char((value >> 7) & 0x7F)).append(char(value & 0x7F));
+        return out;
+    }
+};
+
+// ───────────────────────────────────────────────────────────
+// Field layouts (Size == 0 means variable length, last field only)
+// ───────────────────────────────────────────────────────────
+struct U7 {
+    using Type = quint8;
+    static constexpr int Size = 1;
+    static Type read(const PayloadView &p, int at) { return p[at] & 0x7F; }
+};
+
+struct Byte {
+    using Type = quint8;
+    static constexpr int Size = 1;
+    static Type read(const PayloadView &p, int at) { return p[at]; }
+};
+
+struct U14 {
+    using Type = quint16;
+    static constexpr int Size = 2;
+    static Type read(const PayloadView &p, int at) { return quint16(decode14Bit(p[at], p[at + 1])); }
+};
+
+struct Rgb7 {
+    using Type = QRgb;
+    static constexpr int Size = 3;
+    static Type read(const PayloadView &p, int at) { return rgbFrom7(p.data() + at); }
+};
+
+struct Rgb14 {
+    using Type = QRgb;
+    static constexpr int Size = 6;
+    static Type read(const PayloadView &p, int at) { return rgbFrom14(p.data() + at); }
+};
+
+struct Mask32 {
+    using Type = quint32;
+    static constexpr int Size = Mask32Size;
+    static Type read(const PayloadView &p, int at) { return decodeMask32(p.data() + at); }
+};
+
+// Name fields: bytes only, interned by the handler (see NamePool)
+struct LpBytes {
+    using Type = PayloadView;
+    static constexpr int Size = 0;
+    static Type read(const PayloadView &p, int at) { return lengthPrefixedBytes(p, at); }
+};
+
+struct Utf8String {
+    using Type = QString;
+    static constexpr int Size = 0;
+    static Type read(const PayloadView &p, int at)
+    {
+        return at < p.size() ? QString::fromUtf8(p.constData() + at, p.size() - at) : QString();
+    }
+};
+
+struct Tail {
+    using Type = PayloadView;
+    static constexpr int Size = 0;
+    static Type read(const PayloadView &p, int at)
+    {
+        return at < p.size() ? PayloadView(p.data() + at, p.size() - at) : PayloadView();
+    }
+};
+
+template <typename... Fields>
+struct Layout
+{
+    using Message = std::tuple<typename Fields::Type...>;
+
+    static constexpr int sizes[] = { Fields::Size..., 0 };
+    static constexpr int count = int(sizeof...(Fields));
+
+    static constexpr int offset(int index)
+    {
+        int at = 0;
+        for (int i = 0; i < index; ++i)
+            at += sizes[i];
+        return at;
+    }
+
+    static constexpr bool variableOnlyLast()
+    {
+        for (int i = 0; i + 1 < count; ++i) {
+            if (sizes[i] == 0)
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr int fixedSize = offset(count);
+    static_assert(variableOnlyLast(), "Variable-length fields must be last");
+
+    // Caller guarantees payload.size() >= fixedSize
+    static Message decode(const PayloadView &payload)
+    {
+        return decodeAt(payload, std::index_sequence_for<Fields...>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static Message decodeAt(const PayloadView &payload, std::index_sequence<I...>)
+    {
+        Q_UNUSED(payload)
+        return Message(Fields::read(payload, offset(int(I)))...);
+    }
+};
+
+template <quint8 Id, int MinLen, int MaxLength, typename... Fields>
+struct Command : Layout<Fields...>
+{
+    static constexpr quint8 id = Id;
+    static constexpr quint16 minLen = MinLen;
+    static constexpr quint16 maxLen = MaxLength;
+
+    static_assert(MinLen >= Layout<Fields...>::fixedSize, "minLen must cover the fixed fields");
+    static_assert(MinLen <= MaxLength && MaxLength <= MaxLen, "Invalid length bounds");
+};
+
+// ═══════════════════════════════════════════════════════════
+// SCHEMA (Teensy → GUI)
+// ═══════════════════════════════════════════════════════════
+// max is MaxLen unless the command is new and its size is part of the
+// protocol: trailing bytes past the fixed fields are ignored, as they
+// always were, so padded or extended firmware frames still get through.
+//                   id                       min  max     fields
+using Handshake    = Command<CmdHandshake,      0, MaxLen, Tail>;
+using Ping         = Command<CmdPing,           0, MaxLen, Tail>;
+using Disconnect   = Command<CmdDisconnect,     0, MaxLen, Tail>;
+using LinkCheck    = Command<CmdLinkCheck,      0, MaxLen, Tail>;
+using SelectedTrack = Command<CmdSelectedTrack, 1, MaxLen, U7>;
+
+using ClipName     = Command<CmdClipName,       2, MaxLen, Byte, Byte, LpBytes>;
+using ClipState    = Command<CmdClipState,      3, MaxLen, Byte, Byte, Byte, Tail>;
+using ClipStateRgb = Layout<Byte, Byte, Byte, Rgb14>;                 // len >= 9
+using GridUpdate7  = Command<CmdGridUpdate7bit,  3, MaxLen, Tail>;    // N × Rgb7
+using GridUpdate14 = Command<CmdGridUpdate14bit, 6, MaxLen, Tail>;    // N × Rgb14
+using PadUpdate7   = Command<CmdPadUpdate7bit,   5, MaxLen, Byte, Byte, Rgb7>;
+using PadUpdate14  = Command<CmdPadUpdate14bit,  7, MaxLen, Tail>;    // [pad] or [track, scene] + Rgb14
+using GridDelta14  = Command<CmdGridDelta14bit,  5, 5 + 32 * 6, Mask32, Tail>;  // popcount(mask) × Rgb14
+
+using TrackName    = Command<CmdTrackName,      1, MaxLen, Byte, LpBytes>;
+using TrackColor   = Command<CmdTrackColor,     4, MaxLen, Byte, Tail>;
+using SceneName    = Command<CmdSceneName,      1, MaxLen, Byte, Tail>;     // raw UTF-8
+using SceneColor   = Command<CmdSceneColor,     4, MaxLen, Byte, Tail>;
+using SceneTriggered = Command<CmdSceneTriggered, 2, MaxLen, Byte, Byte>;
+using SceneState   = Command<CmdSceneState,     2, MaxLen, Byte, Byte>;
+using IndexRgb7    = Layout<Byte, Rgb7>;                              // len 4..6
+using IndexRgb14   = Layout<Byte, Rgb14>;                             // len >= 7
+
+using TransportPlay   = Command<CmdTransportPlay,     0, MaxLen, Tail>;
+using TransportRecord = Command<CmdTransportRecord,   0, MaxLen, Tail>;
+using TransportLoop   = Command<CmdTransportLoop,     0, MaxLen, Tail>;
+using TransportTempo  = Command<CmdTransportTempo,    2, MaxLen, U14>;   // BPM × 10
+using TransportPosition = Command<CmdTransportPosition, 1, MaxLen, Utf8String>;
+using TransportState  = Command<CmdTransportState,    1, MaxLen, Byte>;  // bit0 play, bit1 rec, bit2 loop
+using ShiftState      = Command<CmdShiftState,        1, MaxLen, Byte>;
+
+using MixerVolume  = Command<CmdMixerVolume,    3, MaxLen, U7, U14>;
+using MixerPan     = Command<CmdMixerPan,       3, MaxLen, U7, U14>;
+using MixerMute    = Command<CmdMixerMute,      2, MaxLen, U7, U7>;
+using MixerSolo    = Command<CmdMixerSolo,      2, MaxLen, U7, U7>;
+using MixerArm     = Command<CmdMixerArm,       2, MaxLen, U7, U7>;
+using MixerSend    = Command<CmdMixerSend,      4, MaxLen, U7, U7, U14>;
+using MixerMode    = Command<CmdMixerMode,      1, MaxLen, U7>;
+using TrackMeters  = Command<CmdTrackMeters,    3, 1 + 128 * 2, U7, Tail>;  // N × (L, R)
+
+// [track_msb, track_lsb, scene_msb, scene_lsb, width, height, overview]
+using RingPosition = Command<CmdRingPosition,   7, MaxLen, U14, U14, U7, U7, U7>;
+using SessionRingMetadata = Command<CmdSessionRingMetadata, 1,      MaxLen, Tail>;
+using SessionRingClips    = Command<CmdSessionRingClips,    32 * 4, MaxLen, Tail>;
+// Absolute window offsets first, then the bulk body for that window
+using PrefetchMetadata    = Command<CmdPrefetchMetadata,    4 + 1,      MaxLen, U14, U14, Tail>;
+using PrefetchClips       = Command<CmdPrefetchClips,       4 + 32 * 4, MaxLen, U14, U14, Tail>;
+
+} // namespace Protocol
+
+#endif // PROTOCOLSCHEMA_H
@@ -0,0 +1,8 @@
+#include "PushCloneLogging.h"
+
+Q_LOGGING_CATEGORY(lcSerial, "pushclone.serial", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcSerialRx, "pushclone.serial.rx", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcSerialTx, "pushclone.serial.tx", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcProtocol, "pushclone.protocol", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcMixer, "pushclone.mixer", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcSession, "pushclone.session", QtInfoMsg)
@@ -0,0 +1,40 @@
+#ifndef PUSHCLONELOGGING_H
+#define PUSHCLONELOGGING_H
+
+#include <QLoggingCategory>
+
+// ═══════════════════════════════════════════════════════════
+// LOGGING - Categories with compile-time and runtime levels
+// ═══════════════════════════════════════════════════════════
+// Runtime: categories default to info (hot paths to warning) and can be
+// raised per category, e.g.
+//   QT_LOGGING_RULES="pushclone.serial.rx.debug=true;pushclone.mixer.debug=true"
+//
+// Compile time: PUSHCLONE_LOG_MIN_LEVEL drops every PC_* statement below the
+// level entirely (argument formatting included). 0=debug 1=info 2=warning.
+// Frame contents are never formatted on the hot path: see TraceRing.
+
+#ifndef PUSHCLONE_LOG_MIN_LEVEL
+#define PUSHCLONE_LOG_MIN_LEVEL 0
+#endif
+
+#define PC_LOG_LEVEL_DEBUG 0
+#define PC_LOG_LEVEL_INFO 1
+#define PC_LOG_LEVEL_WARNING 2
+
+// Same statement shape as qCDebug: safe as the body of an unbraced if/else
+#define PC_LOG_IF_COMPILED(level) \
+    for (bool pc_log_compiled = PUSHCLONE_LOG_MIN_LEVEL <= (level); pc_log_compiled; pc_log_compiled = false)
+
+#define PC_DEBUG(category) PC_LOG_IF_COMPILED(PC_LOG_LEVEL_DEBUG) qCDebug(category)
+#define PC_INFO(category) PC_LOG_IF_COMPILED(PC_LOG_LEVEL_INFO) qCInfo(category)
+#define PC_WARN(category) PC_LOG_IF_COMPILED(PC_LOG_LEVEL_WARNING) qCWarning(category)
+
+Q_DECLARE_LOGGING_CATEGORY(lcSerial)      // port open/close, errors
+Q_DECLARE_LOGGING_CATEGORY(lcSerialRx)    // per-chunk / per-frame receive
+Q_DECLARE_LOGGING_CATEGORY(lcSerialTx)    // per-frame transmit
+Q_DECLARE_LOGGING_CATEGORY(lcProtocol)    // handshake, dispatch, rejected frames
+Q_DECLARE_LOGGING_CATEGORY(lcMixer)       // mixer handlers and MixerModel
+Q_DECLARE_LOGGING_CATEGORY(lcSession)     // ring position, bulk updates, clips
+
+#endif // PUSHCLONELOGGING_H
@@ -0,0 +1,206 @@
+#include "RingPrefetcher.h"
+
+namespace {
+constexpr double VelocitySmoothing = 0.3;   // EMA weight of the newest move
+}
+
+RingPrefetcher::MoveResult RingPrefetcher::ringMoved(int trackOffset, int sceneOffset, qint64 nowNs)
+{
+    MoveResult result = Miss;
+    if (Window *window = find(trackOffset, sceneOffset)) {
+        if (window->visited)
+            result = Revisit;
+        else if (window->parts == Complete)
+            result = Hit;
+        else
+            result = Partial;
+    } else if (m_inFlight && m_inFlightTrack == trackOffset && m_inFlightScene == sceneOffset) {
+        result = Partial;
+    }
+
+    switch (result) {
+    case Hit: ++m_counters.hits; break;
+    case Partial: ++m_counters.partials; break;
+    case Revisit: ++m_counters.revisits; break;
+    case Miss: ++m_counters.misses; break;
+    }
+
+    // The Teensy re-sends the visible window itself: no need to prefetch it
+    // again while it stays in the LRU
+    Window &current = touch(trackOffset, sceneOffset);
+    current.visited = true;
+    current.parts = Complete;
+
+    if (m_hasPosition) {
+        const int dt = trackOffset - m_track;
+        const int ds = sceneOffset - m_scene;
+        if (dt != 0 || ds != 0) {
+            m_stepTrack = dt;
+            m_stepScene = ds;
+        }
+        const qint64 interval = nowNs - m_lastMoveNs;
+        if (interval > 0) {
+            const double rate = 1e9 / double(interval);
+            m_velocity += VelocitySmoothing * (rate - m_velocity);
+        }
+    }
+    m_hasPosition = true;
+    m_track = trackOffset;
+    m_scene = sceneOffset;
+    m_lastMoveNs = nowNs;
+
+    plan(trackOffset, sceneOffset);
+    return result;
+}
+
+void RingPrefetcher::plan(int track, int scene)
+{
+    m_planSize = 0;
+    m_planNext = 0;
+    m_issued = 0;
+
+    auto add = [this, track, scene](int dt, int ds) {
+        const int t = track + dt;
+        const int s = scene + ds;
+        if (t < 0 || s < 0 || t > 0x3FFF || s > 0x3FFF || (dt == 0 && ds == 0))
+            return;
+        if (m_planSize >= MaxPlan || covered(t, s))
+            return;
+        for (int i = 0; i < m_planSize; ++i) {
+            if (m_plan[i][0] == t && m_plan[i][1] == s)
+                return;
+        }
+        m_plan[m_planSize++] = {t, s};
+    };
+
+    const bool moving = m_stepTrack != 0 || m_stepScene != 0;
+    if (moving) {
+        add(m_stepTrack, m_stepScene);
+        if (m_velocity * double(FastMoveNs) > 1e9)
+            add(2 * m_stepTrack, 2 * m_stepScene);
+    }
+
+    // Page neighbours; the side we are heading to goes first
+    const int trackSign = m_stepTrack < 0 ? -1 : 1;
+    const int sceneSign = m_stepScene < 0 ? -1 : 1;
+    if (qAbs(m_stepScene) > qAbs(m_stepTrack)) {
+        add(0, sceneSign * WindowScenes);
+        add(trackSign * WindowTracks, 0);
+        add(0, -sceneSign * WindowScenes);
+        add(-trackSign * WindowTracks, 0);
+    } else {
+        add(trackSign * WindowTracks, 0);
+        add(0, sceneSign * WindowScenes);
+        add(-trackSign * WindowTracks, 0);
+        add(0, -sceneSign * WindowScenes);
+    }
+}
+
+bool RingPrefetcher::nextRequest(qint64 nowNs, int *trackOffset, int *sceneOffset)
+{
+    if (m_inFlight) {
+        if (nowNs - m_inFlightNs < RequestTimeoutNs)
+            return false;
+        // Older firmware or a lost reply: give up on it and move on
+        m_inFlight = false;
+        ++m_counters.timeouts;
+    }
+
+    while (m_planNext < m_planSize && m_issued < m_maxWindows) {
+        const auto &candidate = m_plan[m_planNext++];
+        // A live move or an earlier reply may have covered it meanwhile
+        if (covered(candidate[0], candidate[1]))
+            continue;
+
+        ++m_issued;
+        ++m_counters.requests;
+        m_inFlight = true;
+        m_inFlightTrack = candidate[0];
+        m_inFlightScene = candidate[1];
+        m_inFlightNs = nowNs;
+        *trackOffset = candidate[0];
+        *sceneOffset = candidate[1];
+        return true;
+    }
+    return false;
+}
+
+void RingPrefetcher::received(int trackOffset, int sceneOffset, Part part, int bytes)
+{
+    m_counters.bytes += quint64(qMax(0, bytes));
+
+    Window *window = find(trackOffset, sceneOffset);
+    if (!window) {
+        window = &touch(trackOffset, sceneOffset);
+        window->fetched = true;
+    }
+    if (window->parts != Complete && (window->parts | part) == Complete)
+        ++m_counters.windowsFetched;
+    window->parts |= part;
+
+    if (m_inFlight && m_inFlightTrack == trackOffset && m_inFlightScene == sceneOffset
+        && window->parts == Complete) {
+        m_inFlight = false;
+    }
+}
+
+double RingPrefetcher::hitRate() const
+{
+    const quint64 moves = m_counters.hits + m_counters.partials + m_counters.misses;
+    return moves ? double(m_counters.hits) / double(moves) : 0.0;
+}
+
+void RingPrefetcher::clear()
+{
+    m_windows.fill(Window());
+    m_windowCount = 0;
+    m_planSize = 0;
+    m_planNext = 0;
+    m_issued = 0;
+    m_inFlight = false;
+    m_hasPosition = false;
+    m_stepTrack = 0;
+    m_stepScene = 0;
+    m_velocity = 0.0;
+}
+
+RingPrefetcher::Window *RingPrefetcher::find(int track, int scene)
+{
+    for (int i = 0; i < m_windowCount; ++i) {
+        Window &window = m_windows[i];
+        if (window.track == track && window.scene == scene)
+            return &window;
+    }
+    return nullptr;
+}
+
+bool RingPrefetcher::covered(int track, int scene)
+{
+    const Window *window = find(track, scene);
+    return window && (window->visited || window->parts == Complete);
+}
+
+RingPrefetcher::Window &RingPrefetcher::touch(int track, int scene)
+{
+    Window *window = find(track, scene);
+    if (!window) {
+        if (m_windowCount < Capacity) {
+            window = &m_windows[m_windowCount++];
+        } else {
+            // 16 entries: a linear scan for the oldest beats any list
+            window = &m_windows[0];
+            for (Window &candidate : m_windows) {
+                if (candidate.lastUse < window->lastUse)
+                    window = &candidate;
+            }
+            ++m_counters.evictions;
+            if (window->fetched && !window->visited)
+                ++m_counters.unusedEvictions;
+        }
+        *window = Window();
+        window->track = track;
+        window->scene = scene;
+    }
+    window->lastUse = ++m_useClock;
+    return *window;
+}
@@ -0,0 +1,119 @@
+#ifndef RINGPREFETCHER_H
+#define RINGPREFETCHER_H
+
+#include <QtGlobal>
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════
+// RING PREFETCHER - Ask for the 8x4 windows the user is heading to
+// ═══════════════════════════════════════════════════════════
+// Fed with every CMD_RING_POSITION: the last step (usually one track/scene
+// or a full page) and how fast moves come in give the direction of travel.
+// The plan for the next idle moments is, in order:
+//   position + step, position + 2 × step (fast moves only),
+//   then the four page neighbours, the direction of travel first.
+// One CMD_RING_PREFETCH is in flight at a time; the controller only sends
+// when the link is otherwise quiet, so prefetch never delays live traffic.
+//
+// Window contents go to the SessionCache like any other session data;
+// this class keeps a bounded LRU of the windows themselves (fetched or
+// visited) to avoid asking twice and to score each move as a hit or miss.
+class RingPrefetcher
+{
+public:
+    static constexpr int WindowTracks = 8;
+    static constexpr int WindowScenes = 4;
+    static constexpr int Capacity = 16;                       // windows tracked
+    static constexpr int MaxPlan = 6;
+    static constexpr qint64 RequestTimeoutNs = 300 * 1000 * 1000;
+    static constexpr qint64 FastMoveNs = 400 * 1000 * 1000;   // look two steps ahead
+
+    enum Part : quint8 {
+        Metadata = 1 << 0,
+        Clips = 1 << 1,
+        Complete = Metadata | Clips
+    };
+
+    enum MoveResult {
+        Miss,        // never seen: waits on the wire
+        Hit,         // prefetched and complete before the move
+        Partial,     // prefetch requested or half received
+        Revisit      // visited before, served from the session cache
+    };
+
+    struct Counters {
+        quint64 requests = 0;
+        quint64 windowsFetched = 0;     // both parts received
+        quint64 bytes = 0;              // prefetch payload bytes received
+        quint64 hits = 0;
+        quint64 partials = 0;
+        quint64 misses = 0;
+        quint64 revisits = 0;
+        quint64 evictions = 0;
+        quint64 unusedEvictions = 0;    // fetched, dropped before any visit
+        quint64 timeouts = 0;
+    };
+
+    // Windows requested per move (0 = off)
+    void setMaxWindows(int windows) { m_maxWindows = qBound(0, windows, MaxPlan); }
+    int maxWindows() const { return m_maxWindows; }
+
+    MoveResult ringMoved(int trackOffset, int sceneOffset, qint64 nowNs);
+    // More requests planned (or one in flight to watch for a timeout)
+    bool hasWork() const { return m_inFlight || (m_planNext < m_planSize && m_issued < m_maxWindows); }
+    // Next window to ask for; false while one is in flight or nothing is left
+    bool nextRequest(qint64 nowNs, int *trackOffset, int *sceneOffset);
+    void received(int trackOffset, int sceneOffset, Part part, int bytes);
+
+    // Moves per second, smoothed
+    double velocity() const { return m_velocity; }
+    const Counters &counters() const { return m_counters; }
+    double hitRate() const;
+    void resetStatistics() { m_counters = Counters(); }
+    void clear();
+
+private:
+    struct Window {
+        int track = -1;
+        int scene = -1;
+        quint64 lastUse = 0;
+        quint8 parts = 0;
+        bool fetched = false;   // came in through prefetch
+        bool visited = false;
+    };
+
+    Window *find(int track, int scene);
+    // Nothing left to ask for: both parts in, or the Teensy sent it live.
+    // A window missing a part (reply lost) gets planned again.
+    bool covered(int track, int scene);
+    Window &touch(int track, int scene);
+    void plan(int track, int scene);
+
+    std::array<Window, Capacity> m_windows {};
+    int m_windowCount = 0;
+    quint64 m_useClock = 0;
+
+    std::array<std::array<int, 2>, MaxPlan> m_plan {};
+    int m_planSize = 0;
+    int m_planNext = 0;
+    int m_issued = 0;
+    int m_maxWindows = 3;
+
+    bool m_inFlight = false;
+    int m_inFlightTrack = 0;
+    int m_inFlightScene = 0;
+    qint64 m_inFlightNs = 0;
+
+    bool m_hasPosition = false;
+    int m_track = 0;
+    int m_scene = 0;
+    int m_stepTrack = 0;
+    int m_stepScene = 0;
+    qint64 m_lastMoveNs = 0;
+    double m_velocity = 0.0;
+
+    Counters m_counters;
+};
+
+#endif // RINGPREFETCHER_H
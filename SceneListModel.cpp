@@ -8,7 +8,7 @@ SceneListModel::SceneListModel(QObject *parent)
     for (int i = 0; i < 4; ++i) {
         SceneInfo scene;
         scene.index = i;
-        scene.name = QStringLiteral("Scene %1").arg(i + 1);
+        scene.placeholder = i + 1;
         scene.color = QColor("#1a1a1a");
         scene.triggered = false;
         m_scenes.append(scene);
@@ -32,7 +32,9 @@ QVariant SceneListModel::data(const QModelIndex &index, int role) const
     case IndexRole:
         return scene.index;
     case NameRole:
-        return scene.name;
+        if (scene.placeholder > 0)
+            return QStringLiteral("Scene %1").arg(scene.placeholder);
+        return NamePool::instance().name(scene.name);
     case ColorRole:
         return scene.color;
     case TriggeredRole:
@@ -52,16 +54,28 @@ QHash<int, QByteArray> SceneListModel::roleNames() const
     };
 }
 
-void SceneListModel::setSceneName(int index, const QString &name)
+void SceneListModel::setSceneName(int index, NamePool::Handle name)
 {
     if (!validIndex(index))
         return;
     SceneInfo &scene = m_scenes[index];
-    if (scene.name == name)
+    if (scene.name == name && scene.placeholder == 0)
         return;
     scene.name = name;
-    const QModelIndex modelIndex = this->index(index, 0);
-    emit dataChanged(modelIndex, modelIndex, { NameRole });
+    scene.placeholder = 0;
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index, ModelUpdateCoalescer::roleMask(NameRole));
+}
+
+void SceneListModel::setScenePlaceholder(int index, int number)
+{
+    if (!validIndex(index))
+        return;
+    SceneInfo &scene = m_scenes[index];
+    if (scene.placeholder == number && scene.name == NamePool::Empty)
+        return;
+    scene.name = NamePool::Empty;
+    scene.placeholder = number;
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index, ModelUpdateCoalescer::roleMask(NameRole));
 }
 
 void SceneListModel::setSceneColor(int index, const QColor &color)
@@ -72,8 +86,7 @@ void SceneListModel::setSceneColor(int index, const QColor &color)
     if (scene.color == color)
         return;
     scene.color = color;
-    const QModelIndex modelIndex = this->index(index, 0);
-    emit dataChanged(modelIndex, modelIndex, { ColorRole });
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index, ModelUpdateCoalescer::roleMask(ColorRole));
 }
 
 void SceneListModel::setSceneTriggered(int index, bool triggered)
@@ -84,11 +97,10 @@ void SceneListModel::setSceneTriggered(int index, bool triggered)
     if (scene.triggered == triggered)
         return;
     scene.triggered = triggered;
-    const QModelIndex modelIndex = this->index(index, 0);
-    emit dataChanged(modelIndex, modelIndex, { TriggeredRole });
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index, ModelUpdateCoalescer::roleMask(TriggeredRole));
 }
 
-void SceneListModel::clearAbove(int lastActiveIndex)
+void SceneListModel::clearAbove(int lastActiveIndex, int firstScene)
 {
     if (m_scenes.isEmpty())
         return;
@@ -100,23 +112,28 @@ void SceneListModel::clearAbove(int lastActiveIndex)
     bool changed = false;
     for (int i = start; i < m_scenes.size(); ++i) {
         SceneInfo &scene = m_scenes[i];
-        QString defaultName = QStringLiteral("Scene %1").arg(i + 1);
+        const int number = firstScene + i + 1;
         QColor defaultColor("#1a1a1a");
 
-        if (scene.name == defaultName && scene.color == defaultColor && !scene.triggered)
+        if (scene.placeholder == number && scene.name == NamePool::Empty && scene.color == defaultColor
+            && !scene.triggered)
             continue;
 
-        scene.name = defaultName;
+        scene.name = NamePool::Empty;
+        scene.placeholder = number;
         scene.color = defaultColor;
         scene.triggered = false;
         changed = true;
     }
 
-    if (changed) {
-        const QModelIndex first = this->index(start, 0);
-        const QModelIndex last = this->index(m_scenes.size() - 1, 0);
-        emit dataChanged(first, last);
-    }
+    if (changed)
+        ModelUpdateCoalescer::notify(m_coalescer, this, start, m_scenes.size() - 1, ModelUpdateCoalescer::AllRoles);
+}
+
+void SceneListModel::markNames(NamePool &pool) const
+{
+    for (const SceneInfo &scene : m_scenes)
+        pool.mark(scene.name);
 }
 
 bool SceneListModel::validIndex(int index) const
@@ -6,9 +6,13 @@
 #include <QVector>
 #include <QString>
 
+#include "ModelUpdateCoalescer.h"
+#include "NamePool.h"
+
 struct SceneInfo {
     int index = 0;
-    QString name;
+    NamePool::Handle name = NamePool::Empty;
+    int placeholder = 0;   // > 0: no name received, shown as "Scene <placeholder>"
     QColor color = QColor("#1a1a1a");
     bool triggered = false;
 };
@@ -31,14 +35,22 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
-    void setSceneName(int index, const QString &name);
+    void setSceneName(int index, NamePool::Handle name);
+    void setSceneName(int index, const QString &name) { setSceneName(index, NamePool::instance().intern(name)); }
+    // "Scene <number>" until a real name arrives; built on read, never interned
+    void setScenePlaceholder(int index, int number);
     void setSceneColor(int index, const QColor &color);
     void setSceneTriggered(int index, bool triggered);
-    void clearAbove(int lastActiveIndex);
+    // Cleared rows show "Scene <firstScene + row + 1>", the absolute number
+    void clearAbove(int lastActiveIndex, int firstScene = 0);
+    void markNames(NamePool &pool) const;
+
+    void setCoalescer(ModelUpdateCoalescer *coalescer) { m_coalescer = coalescer; }
 
 private:
     bool validIndex(int index) const;
     QVector<SceneInfo> m_scenes;
+    ModelUpdateCoalescer *m_coalescer = nullptr;
 };
 
 #endif // SCENELISTMODEL_H
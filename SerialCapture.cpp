@@ -0,0 +1,192 @@
+#include "SerialCapture.h"
+#include "FlightRecorder.h"
+#include "MonotonicClock.h"
+#include "PushCloneLogging.h"
+
+#include <QMutexLocker>
+
+#include <cstring>
+
+void SerialCapture::writeHeader(quint8 *out, quint32 flags)
+{
+    std::memcpy(out, Magic, sizeof(Magic));
+    std::memcpy(out + 8, &Version, sizeof(Version));
+    std::memcpy(out + 12, &flags, sizeof(flags));
+}
+
+void SerialCapture::recordRx(const quint8 *data, int size)
+{
+    if (size <= 0)
+        return;
+
+    const qint64 now = MonotonicClock::nowNs();
+    FlightRecorder::instance().record(now, data, size);
+
+    SerialCaptureWriter &writer = SerialCaptureWriter::instance();
+    if (writer.isActive())
+        writer.append(now, data, size);
+}
+
+// ───────────────────────────────────────────────────────────
+// Writer
+// ───────────────────────────────────────────────────────────
+SerialCaptureWriter &SerialCaptureWriter::instance()
+{
+    static SerialCaptureWriter writer;
+    return writer;
+}
+
+bool SerialCaptureWriter::start(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        PC_WARN(lcSerial) << "Capture: cannot open" << path << m_file.errorString();
+        return false;
+    }
+    if (!remap(InitialMapSize)) {
+        m_file.close();
+        return false;
+    }
+
+    SerialCapture::writeHeader(m_map, SerialCapture::FlagNone);
+    m_writePos = SerialCapture::HeaderSize;
+    m_bytesCaptured.store(0, std::memory_order_relaxed);
+    m_active.store(true, std::memory_order_relaxed);
+    PC_INFO(lcSerial) << "Capturing RX to" << path;
+    return true;
+}
+
+void SerialCaptureWriter::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+}
+
+QString SerialCaptureWriter::path() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_active.load(std::memory_order_relaxed) ? m_file.fileName() : QString();
+}
+
+void SerialCaptureWriter::append(qint64 timestampNs, const quint8 *data, int size)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_map)
+        return;
+
+    const qint64 needed = SerialCapture::RecordHeaderSize + size;
+    if (m_writePos + needed > m_mapSize && !remap(qMax(m_mapSize * 2, m_writePos + needed))) {
+        closeLocked();
+        return;
+    }
+
+    const quint32 length = quint32(size);
+    uchar *out = m_map + m_writePos;
+    std::memcpy(out, &timestampNs, sizeof(timestampNs));
+    std::memcpy(out + 8, &length, sizeof(length));
+    std::memcpy(out + SerialCapture::RecordHeaderSize, data, size_t(size));
+    m_writePos += needed;
+    m_bytesCaptured.fetch_add(size, std::memory_order_relaxed);
+}
+
+bool SerialCaptureWriter::remap(qint64 size)
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (!m_file.resize(size)) {
+        PC_WARN(lcSerial) << "Capture: cannot grow" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+    m_map = m_file.map(0, size);
+    if (!m_map) {
+        PC_WARN(lcSerial) << "Capture: cannot map" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+    m_mapSize = size;
+    return true;
+}
+
+void SerialCaptureWriter::closeLocked()
+{
+    m_active.store(false, std::memory_order_relaxed);
+    if (!m_file.isOpen())
+        return;
+
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    // Trim the preallocated tail so the file ends at the last record
+    m_file.resize(m_writePos);
+    m_file.close();
+    PC_INFO(lcSerial) << "Capture closed:" << m_file.fileName() << m_writePos << "bytes";
+    m_mapSize = 0;
+    m_writePos = 0;
+}
+
+// ───────────────────────────────────────────────────────────
+// Reader
+// ───────────────────────────────────────────────────────────
+bool SerialCaptureReader::open(const QString &path)
+{
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_map = m_size >= SerialCapture::HeaderSize ? m_file.map(0, m_size) : nullptr;
+    if (!m_map || std::memcmp(m_map, SerialCapture::Magic, sizeof(SerialCapture::Magic)) != 0) {
+        m_error = QStringLiteral("not a PushClone capture");
+        close();
+        return false;
+    }
+
+    quint32 version = 0;
+    std::memcpy(&version, m_map + 8, sizeof(version));
+    std::memcpy(&m_flags, m_map + 12, sizeof(m_flags));
+    if (version != SerialCapture::Version) {
+        m_error = QStringLiteral("unsupported capture version %1").arg(version);
+        close();
+        return false;
+    }
+
+    m_readPos = SerialCapture::HeaderSize;
+    return true;
+}
+
+void SerialCaptureReader::close()
+{
+    if (m_map)
+        m_file.unmap(const_cast<uchar *>(m_map));
+    m_map = nullptr;
+    m_size = 0;
+    m_readPos = 0;
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+bool SerialCaptureReader::next(Chunk &chunk)
+{
+    if (!m_map || m_readPos + SerialCapture::RecordHeaderSize > m_size)
+        return false;
+
+    quint32 length = 0;
+    std::memcpy(&chunk.timestampNs, m_map + m_readPos, sizeof(chunk.timestampNs));
+    std::memcpy(&length, m_map + m_readPos + 8, sizeof(length));
+    const qint64 end = m_readPos + SerialCapture::RecordHeaderSize + qint64(length);
+    if (end > m_size)
+        return false;
+
+    chunk.data = m_map + m_readPos + SerialCapture::RecordHeaderSize;
+    chunk.size = int(length);
+    m_readPos = end;
+    return true;
+}
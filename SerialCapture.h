@@ -0,0 +1,98 @@
+#ifndef SERIALCAPTURE_H
+#define SERIALCAPTURE_H
+
+#include <QtGlobal>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+
+#include <atomic>
+
+// ═══════════════════════════════════════════════════════════
+// SERIAL CAPTURE - Raw RX bytes with monotonic timestamps
+// ═══════════════════════════════════════════════════════════
+// File format (native endianness, little-endian on Pi and x86):
+//   header : "PCCAPT\0\0" | quint32 version | quint32 flags
+//   record : qint64 timestampNs | quint32 length | length raw bytes
+// Records are not aligned. The flight recorder dumps the same format, so
+// both kinds of file replay through SerialReplay.
+namespace SerialCapture {
+
+constexpr char Magic[8] = { 'P', 'C', 'C', 'A', 'P', 'T', '\0', '\0' };
+constexpr quint32 Version = 1;
+constexpr int HeaderSize = 16;
+constexpr int RecordHeaderSize = 12;
+
+enum Flags : quint32 {
+    FlagNone = 0,
+    FlagFlightRecorder = 1   // written from a crash handler, may end mid-window
+};
+
+void writeHeader(quint8 *out, quint32 flags);
+
+// Entry point for every RX read (GUI or I/O thread): stamps the chunk once
+// and hands it to the flight recorder and, if active, the capture file.
+void recordRx(const quint8 *data, int size);
+
+} // namespace SerialCapture
+
+// Appends records into a memory-mapped file that grows by remapping.
+// Only the RX thread writes; start/stop may come from the GUI thread.
+class SerialCaptureWriter
+{
+public:
+    static constexpr qint64 InitialMapSize = 8 * 1024 * 1024;
+
+    static SerialCaptureWriter &instance();
+
+    bool start(const QString &path);
+    void stop();
+    bool isActive() const { return m_active.load(std::memory_order_relaxed); }
+    QString path() const;
+    qint64 bytesCaptured() const { return m_bytesCaptured.load(std::memory_order_relaxed); }
+
+    void append(qint64 timestampNs, const quint8 *data, int size);
+
+private:
+    SerialCaptureWriter() = default;
+    bool remap(qint64 size);
+    void closeLocked();
+
+    mutable QMutex m_mutex;
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_mapSize = 0;
+    qint64 m_writePos = 0;
+    std::atomic_bool m_active { false };
+    std::atomic<qint64> m_bytesCaptured { 0 };
+};
+
+// Read-only mapped view of a capture (or flight recorder dump).
+class SerialCaptureReader
+{
+public:
+    struct Chunk {
+        qint64 timestampNs = 0;
+        const quint8 *data = nullptr;
+        int size = 0;
+    };
+
+    bool open(const QString &path);
+    void close();
+    QString errorString() const { return m_error; }
+    quint32 flags() const { return m_flags; }
+
+    // Iterates records in file order; false at the end (or a truncated tail)
+    bool next(Chunk &chunk);
+    void rewind() { m_readPos = SerialCapture::HeaderSize; }
+
+private:
+    QFile m_file;
+    const uchar *m_map = nullptr;
+    qint64 m_size = 0;
+    qint64 m_readPos = 0;
+    quint32 m_flags = 0;
+    QString m_error;
+};
+
+#endif // SERIALCAPTURE_H
@@ -1,65 +1,77 @@
 #include "SerialController.h"
+#include "MonotonicClock.h"
+#include "PushCloneLogging.h"
+#include "TraceRing.h"
+#include "FlightRecorder.h"
+#include "MixerValueTables.h"
+#include "ColorBatch.h"
+#include "NamePool.h"
 
 #include <QCoreApplication>
 #include <QDebug>
 #include <QColor>
 #include <QtMath>
+#include <QtAlgorithms>
+
+using namespace Protocol;
 
 namespace {
 
-int decode14Bit(quint8 msb, quint8 lsb)
+// Frames that keep arriving whether or not the user does anything: they
+// say nothing about whether a prefetch would compete with real traffic
+bool isBackgroundRx(quint8 cmd)
 {
-    return ((msb & 0x7F) << 7) | (lsb & 0x7F);
+    switch (cmd) {
+    case CmdPing:
+    case CmdLinkCheck:
+    case CmdTrackMeters:
+    case CmdTransportPosition:
+    case CmdPrefetchMetadata:
+    case CmdPrefetchClips:
+        return true;
+    default:
+        return false;
+    }
 }
 
-int normalize14To8(quint8 msb, quint8 lsb)
+// One list of a SESSION_RING_METADATA body: [count] then count ×
+// [len, 7-bit name..., R7, G7, B7]. Names come back interned. Stops at a
+// truncated entry and returns the offset right after what was read.
+template <typename Fn>
+int readNamedColors(const PayloadView &payload, int offset, int *count, Fn &&fn)
 {
-    // Colors are packed as two 7-bit MIDI-safe bytes that together represent
-    // the original 0-255 component. Just reconstruct and clamp.
-    return qBound(0, decode14Bit(msb, lsb), 255);
-}
+    *count = payload[offset++] & 0x7F;
+    for (int i = 0; i < *count && offset < payload.size(); ++i) {
+        const int nameLen = payload[offset++] & 0x7F;
+        if (offset + nameLen + 3 > payload.size())
+            break;  // name + RGB
 
-int normalize7To8(quint8 value)
-{
-    return static_cast<int>(((value & 0x7F) * 255) / 127);
-}
+        const NamePool::Handle name = NamePool::instance().intern7bit(payload.data() + offset, nameLen);
+        offset += nameLen;
 
-QColor colorFrom14(const quint8 *data)
-{
-    return QColor(normalize14To8(data[0], data[1]),
-                  normalize14To8(data[2], data[3]),
-                  normalize14To8(data[4], data[5]));
+        // Convert 7-bit to 8-bit
+        const quint8 r8 = quint8((payload[offset++] & 0x7F) << 1);
+        const quint8 g8 = quint8((payload[offset++] & 0x7F) << 1);
+        const quint8 b8 = quint8((payload[offset++] & 0x7F) << 1);
+        fn(i, name, QColor(r8, g8, b8));
+    }
+    return offset;
 }
 
-QColor colorFrom7(const quint8 *data)
+// SESSION_RING_CLIPS body: 32 × [state, R7, G7, B7], column-major
+// (track 0 scenes 0-3, track 1 scenes 0-3, ...), decoded in one pass
+template <typename Fn>
+void readRingClips(const PayloadView &payload, Fn &&fn)
 {
-    return QColor(normalize7To8(data[0]),
-                  normalize7To8(data[1]),
-                  normalize7To8(data[2]));
+    const int count = qMin(payload.size() / 4, ClipGridModel::Cells);
+    std::array<quint8, ClipGridModel::Cells> states;
+    std::array<QRgb, ClipGridModel::Cells> colors;
+    ColorBatch::decodeClips(payload.data(), count, states.data(), colors.data());
+    for (int i = 0; i < count; ++i)
+        fn(i / ClipGridModel::Scenes, i % ClipGridModel::Scenes, int(states[i]), colors[i]);
 }
 
-QString readLengthPrefixedString(const QByteArray &payload, int offset)
-{
-    if (offset >= payload.size())
-        return QString();
-
-    const int remaining = payload.size() - offset;
-    if (remaining <= 0)
-        return QString();
-
-    const quint8 declaredLen = static_cast<quint8>(payload.at(offset));
-    const int available = remaining - 1;
-    if (declaredLen > 0 && available >= declaredLen)
-        return QString::fromUtf8(payload.constData() + offset + 1, declaredLen);
-
-    if (available <= 0)
-        return QString();
-
-    // Fallback: treat the rest as a raw UTF-8 string (legacy packets)
-    return QString::fromUtf8(payload.constData() + offset, remaining);
-}
-}
-constexpr quint8 FrameHeader = 0xAA;
+} // namespace
 
 SerialController::SerialController(QObject *parent)
     : QObject(parent)
@@ -67,14 +79,85 @@ SerialController::SerialController(QObject *parent)
     , m_trackModel(new TrackListModel(this))
     , m_sceneModel(new SceneListModel(this))
     , m_mixerModel(new MixerModel(this))
+    , m_meterStore(new MeterStore(this))
+    , m_modelCoalescer(new ModelUpdateCoalescer(this))
 {
     connect(&m_serial, &QSerialPort::readyRead, this, &SerialController::handleReadyRead);
     connect(&m_serial, &QSerialPort::errorOccurred, this, &SerialController::handleError);
+    // Bytes the port could not take yet go out as soon as it drains
+    connect(&m_serial, &QSerialPort::bytesWritten, this, [this]() {
+        if (!m_txQueue.isEmpty())
+            scheduleTxFlush();
+    });
 
     m_reconnectTimer.setSingleShot(true);
     m_reconnectTimer.setInterval(2000);
     connect(&m_reconnectTimer, &QTimer::timeout, this, &SerialController::handleReconnectTimeout);
 
+    m_linkCheckTimer.setSingleShot(true);
+    m_linkCheckTimer.setInterval(LinkCheckTimeoutMs);
+    connect(&m_linkCheckTimer, &QTimer::timeout, this, &SerialController::handleLinkCheckTimeout);
+
+    m_mixerTxTimer.setTimerType(Qt::PreciseTimer);
+    m_mixerTxTimer.setInterval(1000 / m_mixerTxRateHz);
+    connect(&m_mixerTxTimer, &QTimer::timeout, this, &SerialController::flushMixerTx);
+
+    if (qEnvironmentVariableIsSet("PUSHCLONE_PING_MS"))
+        m_pingIntervalMs = qMax(0, qEnvironmentVariableIntValue("PUSHCLONE_PING_MS"));
+    m_pingTimer.setInterval(qMax(1, m_pingIntervalMs));
+    connect(&m_pingTimer, &QTimer::timeout, this, &SerialController::sendPing);
+
+    // How many neighbouring windows to ask for per ring move (0 = off)
+    if (qEnvironmentVariableIsSet("PUSHCLONE_PREFETCH_WINDOWS"))
+        m_ringPrefetcher.setMaxWindows(qEnvironmentVariableIntValue("PUSHCLONE_PREFETCH_WINDOWS"));
+    m_prefetchTimer.setSingleShot(true);
+    m_prefetchTimer.setInterval(PrefetchIdleMs);
+    connect(&m_prefetchTimer, &QTimer::timeout, this, &SerialController::sendRingPrefetch);
+
+    // Frame-aligned notifications: off until main.cpp attaches a window
+    m_modelCoalescer->addModel(m_clipModel, QStringLiteral("clips"));
+    m_modelCoalescer->addModel(m_trackModel, QStringLiteral("tracks"));
+    m_modelCoalescer->addModel(m_sceneModel, QStringLiteral("scenes"));
+    m_modelCoalescer->addModel(m_mixerModel, QStringLiteral("mixer"));
+    m_clipModel->setCoalescer(m_modelCoalescer);
+    m_trackModel->setCoalescer(m_modelCoalescer);
+    m_sceneModel->setCoalescer(m_modelCoalescer);
+    m_mixerModel->setCoalescer(m_modelCoalescer);
+
+    // First model change inside a handler closes its "model" stage
+    m_latencyTracer.setEnabled(qEnvironmentVariableIntValue("PUSHCLONE_LATENCY_TRACE_OFF") == 0);
+    const auto markModelChanged = [this]() {
+        if (m_latencyTracer.dispatching())
+            m_latencyTracer.modelChanged(MonotonicClock::nowNs());
+    };
+    // While coalescing, dataChanged only comes out at the next frame
+    connect(m_modelCoalescer, &ModelUpdateCoalescer::changeRecorded, this, markModelChanged);
+    for (QAbstractItemModel *model : { static_cast<QAbstractItemModel *>(m_clipModel),
+                                       static_cast<QAbstractItemModel *>(m_trackModel),
+                                       static_cast<QAbstractItemModel *>(m_sceneModel),
+                                       static_cast<QAbstractItemModel *>(m_mixerModel) }) {
+        connect(model, &QAbstractItemModel::dataChanged, this, markModelChanged);
+        connect(model, &QAbstractItemModel::modelReset, this, markModelChanged);
+        connect(model, &QAbstractItemModel::rowsInserted, this, markModelChanged);
+        connect(model, &QAbstractItemModel::rowsRemoved, this, markModelChanged);
+    }
+
+    connect(m_mixerModel, &MixerModel::trackVolumeChangeRequested, this, [this](int track, float volume) {
+        queueMixerParameter(track, MixerTxCoalescer::Volume, volume);
+    });
+    connect(m_mixerModel, &MixerModel::trackPanChangeRequested, this, [this](int track, float pan) {
+        queueMixerParameter(track, MixerTxCoalescer::Pan, pan);
+    });
+    connect(m_mixerModel, &MixerModel::trackSendChangeRequested, this, [this](int track, int send, float value) {
+        if (send >= 0 && send < 4)
+            queueMixerParameter(track, MixerTxCoalescer::SendA + send, value);
+    });
+    connect(m_mixerModel, &MixerModel::trackParameterReleased, this, [this](int track, int parameter) {
+        // Final value goes out now, not on the next tick
+        m_mixerTx.markFinal(track, parameter);
+        flushMixerTx();
+    });
+
     m_trackCleanupTimer.setSingleShot(true);
     m_trackCleanupTimer.setInterval(100);
     connect(&m_trackCleanupTimer, &QTimer::timeout, this, &SerialController::handleTrackBatchTimeout);
@@ -82,9 +165,40 @@ SerialController::SerialController(QObject *parent)
     m_trackPresence.resize(8);
     m_trackPresence.fill(false);
 
+    m_threadedIo = qEnvironmentVariableIntValue("PUSHCLONE_SERIAL_THREAD") != 0;
+
+    // Port override for headless runs, e.g. against tools/teensy_sim's PTY
+    const QString portOverride = qEnvironmentVariable("PUSHCLONE_PORT");
+    if (!portOverride.isEmpty())
+        m_portName = portOverride;
+    if (qEnvironmentVariableIsSet("PUSHCLONE_MAX_BAUD"))
+        m_maxBaudRate = qEnvironmentVariableIntValue("PUSHCLONE_MAX_BAUD");
+    m_linkBaudRate = m_baudRate;
+
+    m_replay.setSink([this](const char *data, int size) { injectRxBytes(data, size); });
+    // Models keep the replayed state; reconnect() goes back to the real port
+    connect(&m_replay, &SerialReplay::finished, this, &SerialController::replayActiveChanged);
+
+    const QString capturePath = qEnvironmentVariable("PUSHCLONE_CAPTURE");
+    if (!capturePath.isEmpty())
+        startCapture(capturePath);
+
+    // Replay instead of the real port: PUSHCLONE_REPLAY=file [PUSHCLONE_REPLAY_FAST=1]
+    const QString replayPath = qEnvironmentVariable("PUSHCLONE_REPLAY");
+    if (!replayPath.isEmpty()) {
+        const bool realtime = qEnvironmentVariableIntValue("PUSHCLONE_REPLAY_FAST") == 0;
+        QTimer::singleShot(0, this, [this, replayPath, realtime]() { startReplay(replayPath, realtime); });
+        return;
+    }
+
     openPort();
 }
 
+SerialController::~SerialController()
+{
+    stopIoThread();
+}
+
 void SerialController::setPortName(const QString &name)
 {
     if (m_portName == name)
@@ -92,6 +206,7 @@ void SerialController::setPortName(const QString &name)
 
     m_portName = name;
     emit portNameChanged();
+    m_baudSwitchDisabled = false;   // new port, new cable
     reconnect();
 }
 
@@ -105,6 +220,328 @@ void SerialController::setBaudRate(int baud)
     reconnect();
 }
 
+void SerialController::setMaxBaudRate(int baud)
+{
+    if (m_maxBaudRate == baud)
+        return;
+
+    // Applies from the next handshake; the current link is left alone
+    m_maxBaudRate = baud;
+    m_baudSwitchDisabled = false;
+    emit maxBaudRateChanged();
+}
+
+void SerialController::setMixerTxRateHz(int hz)
+{
+    hz = qBound(1, hz, 1000);
+    if (m_mixerTxRateHz == hz)
+        return;
+
+    m_mixerTxRateHz = hz;
+    m_mixerTxTimer.setInterval(1000 / hz);
+    emit mixerTxRateHzChanged();
+}
+
+void SerialController::setPingIntervalMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_pingIntervalMs == ms)
+        return;
+
+    m_pingIntervalMs = ms;
+    m_pingTimer.setInterval(qMax(1, ms));
+    if (ms == 0)
+        m_pingTimer.stop();
+    else if (m_connectionState == Connected)
+        m_pingTimer.start();
+    emit pingIntervalMsChanged();
+}
+
+void SerialController::setThreadedIo(bool enabled)
+{
+    if (m_threadedIo == enabled)
+        return;
+
+    closePort();
+    if (!enabled)
+        stopIoThread();
+    m_threadedIo = enabled;
+    emit threadedIoChanged();
+    openPort();
+}
+
+QVariantMap SerialController::statistics() const
+{
+    QVariantMap stats;
+    stats.insert(QStringLiteral("threadedIo"), m_threadedIo);
+    stats.insert(QStringLiteral("rxFramesParsed"), m_threadedIo ? m_rxEventsDelivered
+                                                               : m_rxParser.framesParsed());
+    stats.insert(QStringLiteral("rxChecksumErrors"), m_ioWorker ? m_ioWorker->checksumErrors()
+                                                               : m_rxParser.checksumErrors());
+    stats.insert(QStringLiteral("rxBytesDiscarded"), m_rxParser.bytesDiscarded());
+    stats.insert(QStringLiteral("framingVersion"), int(m_txQueue.framingVersion()));
+    stats.insert(QStringLiteral("linkBaudRate"), m_linkBaudRate);
+    stats.insert(QStringLiteral("linkFeatures"), m_linkFeatures);
+    stats.insert(QStringLiteral("linkPeerMaxPayload"), m_peerMaxPayload);
+    stats.insert(QStringLiteral("baudSwitches"), m_baudSwitches);
+    stats.insert(QStringLiteral("baudFallbacks"), m_baudFallbacks);
+    stats.insert(QStringLiteral("rxFramingFallbacks"), m_ioWorker ? m_ioWorker->framingFallbacks()
+                                                                 : m_rxParser.framingFallbacks());
+    stats.insert(QStringLiteral("rxQueueDepth"), m_rxQueue.size());
+    stats.insert(QStringLiteral("rxQueueDepthMax"), m_rxQueueDepthMax);
+    stats.insert(QStringLiteral("rxQueueFullStalls"), m_ioWorker ? m_ioWorker->queueFullStalls() : 0);
+    stats.insert(QStringLiteral("rxEventsDelivered"), m_rxEventsDelivered);
+    stats.insert(QStringLiteral("rxDrains"), m_rxDrains);
+    stats.insert(QStringLiteral("handoffLatencyAvgUs"),
+                 m_rxEventsDelivered ? m_handoffLatencyTotalNs / 1000.0 / m_rxEventsDelivered : 0.0);
+    stats.insert(QStringLiteral("handoffLatencyMaxUs"), m_handoffLatencyMaxNs / 1000.0);
+
+    QVariantMap commands;
+    QVariantMap rejected;
+    for (int cmd = 0; cmd < 256; ++cmd) {
+        const QString key = QStringLiteral("0x%1").arg(cmd, 2, 16, QLatin1Char('0'));
+        if (m_rxCommandCounts[cmd])
+            commands.insert(key, m_rxCommandCounts[cmd]);
+        if (m_rxCommandRejected[cmd])
+            rejected.insert(key, m_rxCommandRejected[cmd]);
+    }
+    stats.insert(QStringLiteral("rxCommands"), commands);
+    stats.insert(QStringLiteral("rxCommandsRejected"), rejected);
+    stats.insert(QStringLiteral("rxUnknownCommands"), m_rxUnknownCommands);
+    stats.insert(QStringLiteral("gridDeltaFrames"), m_gridDeltaFrames);
+    stats.insert(QStringLiteral("gridDeltaPads"), m_gridDeltaPads);
+    stats.insert(QStringLiteral("gridDeltaBytesSaved"), m_gridDeltaBytesSaved);
+    stats.insert(QStringLiteral("ringMoves"), m_ringMoves);
+    stats.insert(QStringLiteral("ringCacheHits"), m_ringCacheHits);
+    stats.insert(QStringLiteral("ringCacheMisses"), m_ringCacheMisses);
+    stats.insert(QStringLiteral("sessionCacheClips"), m_sessionCache.clipCount());
+    stats.insert(QStringLiteral("sessionCacheTracks"), m_sessionCache.trackCount());
+    stats.insert(QStringLiteral("sessionCacheScenes"), m_sessionCache.sceneCount());
+    stats.insert(QStringLiteral("sessionCacheOverflows"), m_sessionCache.overflows());
+    stats.insert(QStringLiteral("namePoolSize"), NamePool::instance().size());
+    stats.insert(QStringLiteral("namePoolLookups"), NamePool::instance().lookups());
+    stats.insert(QStringLiteral("namePoolInserts"), NamePool::instance().inserts());
+    stats.insert(QStringLiteral("namePoolRejected"), NamePool::instance().rejected());
+    stats.insert(QStringLiteral("namePoolReclaimed"), NamePool::instance().reclaimed());
+
+    const RingPrefetcher::Counters &prefetch = m_ringPrefetcher.counters();
+    QVariantMap ringPrefetch;
+    ringPrefetch.insert(QStringLiteral("maxWindows"), m_ringPrefetcher.maxWindows());
+    ringPrefetch.insert(QStringLiteral("requests"), prefetch.requests);
+    ringPrefetch.insert(QStringLiteral("windowsFetched"), prefetch.windowsFetched);
+    ringPrefetch.insert(QStringLiteral("bytes"), prefetch.bytes);
+    ringPrefetch.insert(QStringLiteral("hits"), prefetch.hits);
+    ringPrefetch.insert(QStringLiteral("partials"), prefetch.partials);
+    ringPrefetch.insert(QStringLiteral("misses"), prefetch.misses);
+    ringPrefetch.insert(QStringLiteral("revisits"), prefetch.revisits);
+    ringPrefetch.insert(QStringLiteral("hitRate"), m_ringPrefetcher.hitRate());
+    ringPrefetch.insert(QStringLiteral("evictions"), prefetch.evictions);
+    ringPrefetch.insert(QStringLiteral("unusedEvictions"), prefetch.unusedEvictions);
+    ringPrefetch.insert(QStringLiteral("timeouts"), prefetch.timeouts);
+    ringPrefetch.insert(QStringLiteral("movesPerSecond"), m_ringPrefetcher.velocity());
+    stats.insert(QStringLiteral("ringPrefetch"), ringPrefetch);
+    stats.insert(QStringLiteral("meterFrames"), m_meterStore->updates());
+    stats.insert(QStringLiteral("meterNotifications"), m_meterStore->notifications());
+    stats.insert(QStringLiteral("meterSteps"), m_meterStore->steps());
+    stats.insert(QStringLiteral("modelUpdates"), m_modelCoalescer->statistics());
+    stats.insert(QStringLiteral("clipNotifications"), m_clipModel ? m_clipModel->emissions() : 0);
+
+    QVariantMap mixerTx;
+    for (int parameter = 0; parameter < MixerTxCoalescer::ParameterCount; ++parameter) {
+        const MixerTxCoalescer::Counters &c = m_mixerTx.counters(parameter);
+        if (!c.requested && !c.finals)
+            continue;
+        QVariantMap counters;
+        counters.insert(QStringLiteral("requested"), c.requested);
+        counters.insert(QStringLiteral("sent"), c.sent);
+        const quint64 valueSends = c.sent - c.finals;   // finals re-send a value already counted
+        counters.insert(QStringLiteral("coalesced"), c.requested > valueSends ? c.requested - valueSends : 0);
+        counters.insert(QStringLiteral("finals"), c.finals);
+        mixerTx.insert(QString::fromLatin1(MixerTxCoalescer::parameterName(parameter)), counters);
+    }
+    stats.insert(QStringLiteral("mixerTx"), mixerTx);
+    stats.insert(QStringLiteral("mixerTxRateHz"), m_mixerTxRateHz);
+
+    stats.insert(QStringLiteral("pingIntervalMs"), m_pingIntervalMs);
+    stats.insert(QStringLiteral("pingsSent"), m_pingsSent);
+    stats.insert(QStringLiteral("pingsReceived"), m_pingRtt.count());
+    stats.insert(QStringLiteral("pingsLost"), m_pingsLost);
+    stats.insert(QStringLiteral("pingsUnmatched"), m_pingsUnmatched);
+    stats.insert(QStringLiteral("pingRttMinUs"), m_pingRtt.min());
+    stats.insert(QStringLiteral("pingRttAvgUs"), m_pingRtt.mean());
+    stats.insert(QStringLiteral("pingRttP50Us"), m_pingRtt.percentile(50.0));
+    stats.insert(QStringLiteral("pingRttP90Us"), m_pingRtt.percentile(90.0));
+    stats.insert(QStringLiteral("pingRttP99Us"), m_pingRtt.percentile(99.0));
+    stats.insert(QStringLiteral("pingRttP999Us"), m_pingRtt.percentile(99.9));
+    stats.insert(QStringLiteral("pingRttMaxUs"), m_pingRtt.max());
+
+    stats.insert(QStringLiteral("updateLatency"), m_latencyTracer.statistics());
+    stats.insert(QStringLiteral("updateLatencyFrames"), m_latencyTracer.framesSwapped());
+    stats.insert(QStringLiteral("updateLatencyOverflows"), m_latencyTracer.pendingOverflows());
+    stats.insert(QStringLiteral("updateLatencyStale"), m_latencyTracer.staleUpdates());
+
+    const bool workerTx = m_threadedIo && m_ioWorker;
+    const quint64 writes = workerTx ? m_ioWorker->txWrites() : m_txWrites;
+    const qint64 stallTotalNs = workerTx ? m_ioWorker->txWriteStallTotalNs() : m_txWriteStallTotalNs;
+    const qint64 stallMaxNs = workerTx ? m_ioWorker->txWriteStallMaxNs() : m_txWriteStallMaxNs;
+    stats.insert(QStringLiteral("txQueueDepth"), m_txQueue.pendingFrames());
+    stats.insert(QStringLiteral("txQueueBytes"), m_txQueue.pendingBytes());
+    stats.insert(QStringLiteral("txQueueDepthMax"), m_txQueue.maxPendingFrames());
+    stats.insert(QStringLiteral("txQueueBytesMax"), m_txQueue.maxPendingBytes());
+    stats.insert(QStringLiteral("txFramesQueued"), m_txQueue.framesQueued());
+    stats.insert(QStringLiteral("txBatches"), m_txBatches);
+    stats.insert(QStringLiteral("txBacklogBytes"), workerTx ? m_ioWorker->txBacklogBytes()
+                                                            : m_serial.bytesToWrite());
+    stats.insert(QStringLiteral("txWriteStallAvgUs"), writes ? stallTotalNs / 1000.0 / writes : 0.0);
+    stats.insert(QStringLiteral("txWriteStallMaxUs"), stallMaxNs / 1000.0);
+
+    stats.insert(QStringLiteral("captureActive"), SerialCaptureWriter::instance().isActive());
+    stats.insert(QStringLiteral("captureBytes"), SerialCaptureWriter::instance().bytesCaptured());
+    stats.insert(QStringLiteral("replayActive"), m_replay.isActive());
+    stats.insert(QStringLiteral("replayChunks"), m_replay.chunksReplayed());
+    stats.insert(QStringLiteral("replayBytes"), m_replay.bytesReplayed());
+    stats.insert(QStringLiteral("replayElapsedMs"), m_replay.elapsedNs() / 1e6);
+    return stats;
+}
+
+void SerialController::resetStatistics()
+{
+    m_rxEventsDelivered = 0;
+    m_rxDrains = 0;
+    m_rxQueueDepthMax = 0;
+    m_handoffLatencyTotalNs = 0;
+    m_handoffLatencyMaxNs = 0;
+    m_rxCommandCounts.fill(0);
+    m_rxCommandRejected.fill(0);
+    m_rxUnknownCommands = 0;
+    m_gridDeltaFrames = 0;
+    m_gridDeltaPads = 0;
+    m_gridDeltaBytesSaved = 0;
+    m_ringMoves = 0;
+    m_ringCacheHits = 0;
+    m_ringCacheMisses = 0;
+    m_ringPrefetcher.resetStatistics();
+    m_baudSwitches = 0;
+    m_baudFallbacks = 0;
+    m_txQueue.resetStatistics();
+    m_mixerTx.resetStatistics();
+    m_pingRtt.reset();
+    m_pingsSent = 0;
+    m_pingsLost = 0;
+    m_pingsUnmatched = 0;
+    emit pingStatsChanged();
+    m_meterStore->resetStatistics();
+    m_modelCoalescer->resetStatistics();
+    m_latencyTracer.reset();
+    m_txBatches = 0;
+    m_txWrites = 0;
+    m_txWriteStallTotalNs = 0;
+    m_txWriteStallMaxNs = 0;
+    if (m_ioWorker)
+        m_ioWorker->resetTxStatistics();
+}
+
+bool SerialController::dumpTrace(const QString &path) const
+{
+    const bool ok = TraceRing::instance().dumpToFile(path);
+    if (ok) {
+        PC_INFO(lcSerial) << "Trace ring written to" << path;
+    } else {
+        PC_WARN(lcSerial) << "Could not write trace ring to" << path;
+    }
+    return ok;
+}
+
+bool SerialController::dumpPingHistogram(const QString &path) const
+{
+    const bool ok = m_pingRtt.dumpToFile(path, 1000.0);
+    if (ok) {
+        PC_INFO(lcSerial) << "Ping histogram written to" << path << "(" << m_pingRtt.count() << "samples)";
+    } else {
+        PC_WARN(lcSerial) << "Could not write ping histogram to" << path;
+    }
+    return ok;
+}
+
+bool SerialController::dumpUpdateLatency(const QString &path) const
+{
+    const bool ok = m_latencyTracer.dumpToFile(path);
+    if (ok) {
+        PC_INFO(lcSerial) << "Update latency written to" << path;
+    } else {
+        PC_WARN(lcSerial) << "Could not write update latency to" << path;
+    }
+    return ok;
+}
+
+void SerialController::notifyAfterAnimating()
+{
+    // Deferred model notifications go out once per frame, before sync;
+    // meter ballistics advance once per rendered frame
+    m_modelCoalescer->flush();
+    m_meterStore->advanceFrame(MonotonicClock::nowNs());
+}
+
+void SerialController::notifyFrameSwapped()
+{
+    m_latencyTracer.frameSwapped(MonotonicClock::nowNs());
+}
+
+bool SerialController::startCapture(const QString &path)
+{
+    const bool ok = SerialCaptureWriter::instance().start(path);
+    emit captureActiveChanged();
+    return ok;
+}
+
+void SerialController::stopCapture()
+{
+    SerialCaptureWriter::instance().stop();
+    emit captureActiveChanged();
+}
+
+bool SerialController::captureActive() const
+{
+    return SerialCaptureWriter::instance().isActive();
+}
+
+bool SerialController::startReplay(const QString &path, bool realtime)
+{
+    // The replay owns the RX path: close the real port and keep it closed
+    m_replay.stop();
+    closePort();
+    m_reconnectTimer.stop();
+    m_rxParser.clear();
+
+    if (!m_replay.start(path, realtime ? SerialReplay::Realtime : SerialReplay::AsFastAsPossible)) {
+        emit connectionError(tr("Unable to replay %1: %2").arg(path, m_replay.errorString()));
+        openPort();
+        return false;
+    }
+
+    setConnectionState(WaitingHandshake);
+    emit replayActiveChanged();
+    return true;
+}
+
+void SerialController::stopReplay()
+{
+    if (!m_replay.isActive())
+        return;
+
+    m_replay.stop();
+    m_rxParser.clear();
+    setConnected(false);
+    setConnectionState(Disconnected);
+    emit replayActiveChanged();
+    openPort();
+}
+
+bool SerialController::dumpFlightRecorder(const QString &path) const
+{
+    return FlightRecorder::instance().dumpToFile(path);
+}
+
 void SerialController::reconnect()
 {
     closePort();
@@ -113,58 +550,74 @@ void SerialController::reconnect()
 
 void SerialController::requestDisconnect()
 {
-    if (m_serial.isOpen()) {
-        qInfo() << "Solicitando desconexión (CMD_DISCONNECT)";
+    if (isPortOpen()) {
+        PC_INFO(lcProtocol) << "Solicitando desconexión (CMD_DISCONNECT)";
         sendFrame(CmdDisconnect);
     }
+    // The firmware handshakes again in v1
+    setFramingVersion(SerialFrameParser::FramingV1);
     setConnected(false);
     setConnectionState(WaitingHandshake);
 }
 
 void SerialController::sendTransportPlay(bool state)
 {
-    QByteArray payload(1, char(state ? 1 : 0));
-    sendFrame(CmdTransportPlay, payload);
+    const quint8 payload[] = { quint8(state ? 1 : 0) };
+    sendFrame(CmdTransportPlay, payload, sizeof(payload));
 }
 
 void SerialController::sendTransportRecord(bool state)
 {
-    QByteArray payload(1, char(state ? 1 : 0));
-    sendFrame(CmdTransportRecord, payload);
+    const quint8 payload[] = { quint8(state ? 1 : 0) };
+    sendFrame(CmdTransportRecord, payload, sizeof(payload));
 }
 
 void SerialController::sendTransportLoop(bool state)
 {
-    QByteArray payload(1, char(state ? 1 : 0));
-    sendFrame(CmdTransportLoop, payload);
+    const quint8 payload[] = { quint8(state ? 1 : 0) };
+    sendFrame(CmdTransportLoop, payload, sizeof(payload));
 }
 
 void SerialController::sendClipTrigger(int track, int scene)
 {
-    QByteArray payload;
-    payload.append(static_cast<char>(track));
-    payload.append(static_cast<char>(scene));
-    sendFrame(CmdClipTrigger, payload);
+    const quint8 payload[] = { quint8(track), quint8(scene) };
+    sendFrame(CmdClipTrigger, payload, sizeof(payload));
 }
 
 void SerialController::sendMixerBankChange(int bank)
 {
-    qDebug() << "📤 Sending mixer bank change to Teensy: bank" << bank;
-    QByteArray payload;
-    payload.append(static_cast<char>(bank & 0x7F));
-    sendFrame(CmdMixerBankChange, payload);
+    PC_DEBUG(lcSerialTx) << "📤 Sending mixer bank change to Teensy: bank" << bank;
+    const quint8 payload[] = { quint8(bank & 0x7F) };
+    sendFrame(CmdMixerBankChange, payload, sizeof(payload));
 }
 
 void SerialController::sendTrackSelect(int trackIndex)
 {
-    qDebug() << "📤 Sending track select to Teensy: track" << trackIndex;
-    QByteArray payload;
-    payload.append(static_cast<char>(trackIndex & 0x7F));
-    sendFrame(CmdTrackSelect, payload);
+    PC_DEBUG(lcSerialTx) << "📤 Sending track select to Teensy: track" << trackIndex;
+    const quint8 payload[] = { quint8(trackIndex & 0x7F) };
+    sendFrame(CmdTrackSelect, payload, sizeof(payload));
 }
 
 void SerialController::openPort()
 {
+    if (m_replay.isActive())
+        return;
+
+    if (m_threadedIo) {
+        if (m_ioPortOpen || m_ioOpenPending)
+            return;
+        startIoThread();
+        m_ioOpenPending = true;
+        const QString portName = m_portName;
+        const int baudRate = m_baudRate;
+        const quint64 generation = ++m_ioGeneration;
+        SerialIoWorker *worker = m_ioWorker;
+        QMetaObject::invokeMethod(m_ioWorker, [worker, portName, baudRate, generation]() {
+            worker->open(portName, baudRate, generation);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
     if (m_serial.isOpen())
         return;
 
@@ -177,26 +630,46 @@ void SerialController::openPort()
 
     if (!m_serial.open(QIODevice::ReadWrite)) {
         const QString message = tr("Unable to open %1: %2").arg(m_portName, m_serial.errorString());
-        qWarning() << message;
+        PC_WARN(lcSerial) << message;
         emit connectionError(message);
         if (!m_reconnectTimer.isActive())
             m_reconnectTimer.start();
         return;
     }
 
-    qInfo() << "Serial port opened on" << m_portName << "@" << m_baudRate;
+    PC_INFO(lcSerial) << "Serial port opened on" << m_portName << "@" << m_baudRate;
     setConnectionState(WaitingHandshake);
 }
 
 void SerialController::closePort()
 {
-    if (!m_serial.isOpen())
-        return;
+    // Frames sent earlier in this event-loop turn still go out before closing
+    flushTxQueue();
+    m_txQueue.clear();
+    m_mixerTxTimer.stop();
+    m_mixerTx.clear();
+
+    if (m_threadedIo) {
+        if (!m_ioPortOpen && !m_ioOpenPending)
+            return;
+        // Frames still queued from this session are dropped on drain
+        ++m_ioGeneration;
+        m_ioPortOpen = false;
+        m_ioOpenPending = false;
+        if (m_ioWorker)
+            QMetaObject::invokeMethod(m_ioWorker, &SerialIoWorker::close, Qt::QueuedConnection);
+    } else {
+        if (!m_serial.isOpen())
+            return;
+        m_serial.flush();   // last batch (e.g. CMD_DISCONNECT) before the fd goes away
+        m_serial.close();
+    }
 
-    m_serial.close();
     setConnected(false);
     setConnectionState(Disconnected);
-    m_rxBuffer.clear();
+    m_rxParser.clear();
+    setFramingVersion(SerialFrameParser::FramingV1);
+    resetLinkCaps();
     m_trackCleanupTimer.stop();
     m_trackBatchSawZero = false;
     m_trackPresence.fill(false);
@@ -206,58 +679,49 @@ void SerialController::closePort()
 
 void SerialController::handleReadyRead()
 {
-    const QByteArray chunk = m_serial.readAll();
-    if (!chunk.isEmpty()) {
-        qInfo().noquote() << QStringLiteral("[RX] RAW %1")
-                             .arg(QString::fromLatin1(chunk.toHex(' ')));
-    }
-    m_rxBuffer.append(chunk);
-
-    while (true) {
-        const int syncIndex = m_rxBuffer.indexOf(char(FrameHeader));
-        if (syncIndex < 0) {
-            // No byte de sincronización en el buffer -> descartar ruido
-            if (!m_rxBuffer.isEmpty())
-                qWarning() << "Descartando" << m_rxBuffer.size() << "bytes sin SYNC";
-            m_rxBuffer.clear();
-            break;
-        }
-
-        if (syncIndex > 0) {
-            // Quitar bytes previos hasta el siguiente SYNC
-            m_rxBuffer.remove(0, syncIndex);
+    qint64 received = 0;
+    do {
+        // Read straight into the parser ring; loop in case the device holds
+        // more than the free space left after the previous parse pass.
+        m_rxTimestampNs = MonotonicClock::nowNs();
+        received = m_rxParser.readFrom(m_serial);
+        if (received > 0) {
+            TraceRing::instance().record(TraceRing::RxChunk, 0, nullptr, int(received));
+            m_rxParser.visitLastWritten(int(received), SerialCapture::recordRx);
         }
+        parseRxBuffer();
+    } while (received > 0 && m_serial.isOpen() && m_serial.bytesAvailable() > 0);
+    m_rxTimestampNs = 0;
+}
 
-        if (m_rxBuffer.size() < 3)
-            break;
-
-        const quint8 cmd = quint8(m_rxBuffer.at(1));
-        const quint8 len = quint8(m_rxBuffer.at(2));
-
-        const int totalSize = 3 + len + 1;
-        if (m_rxBuffer.size() < totalSize)
-            return; // wait for more data
-
-        const QByteArray payload = m_rxBuffer.mid(3, len);
-        const quint8 checksum = quint8(m_rxBuffer.at(3 + len));
-        if (checksum != calculateChecksum(cmd, len, payload)) {
-            qWarning() << "Checksum mismatch for cmd" << Qt::hex << cmd
-                       << "len" << len
-                       << "payload" << payload.toHex(' ');
-            // Reiniciar parser desde el próximo SYNC
-            m_rxBuffer.remove(0, 1);
-            continue;
+void SerialController::injectRxBytes(const char *data, int size)
+{
+    // Replay and benchmarks: the bytes "arrive" now
+    m_rxTimestampNs = MonotonicClock::nowNs();
+    while (size > 0) {
+        const int taken = m_rxParser.append(data, size);
+        data += taken;
+        size -= taken;
+        // A full ring always holds a complete frame or garbage to skip
+        if (parseRxBuffer() == 0 && taken == 0) {
+            m_rxParser.clear();
         }
+    }
+    m_rxTimestampNs = 0;
+}
 
-        qInfo().noquote() << QStringLiteral("[RX] FRAME cmd=0x%1 len=%2 payload=%3")
-                             .arg(cmd, 2, 16, QLatin1Char('0'))
-                             .arg(len)
-                             .arg(QString::fromLatin1(payload.toHex(' ')));
+int SerialController::parseRxBuffer()
+{
+    const int frames = m_rxParser.parse([this](quint8 cmd, const PayloadView &payload) {
+        TraceRing::instance().record(TraceRing::RxFrame, cmd, payload.data(), payload.size());
+        PC_DEBUG(lcSerialRx) << "RX cmd" << Qt::hex << cmd << "len" << Qt::dec << payload.size();
         processFrame(cmd, payload);
-        m_rxBuffer.remove(0, totalSize);
-        // Reset parser state before continuar
-        continue;
-    }
+    });
+
+    // The parser dropped back to v1 on its own: the peer restarted
+    if (m_rxParser.framingVersion() != m_txQueue.framingVersion())
+        handleLinkLost();
+    return frames;
 }
 
 void SerialController::handleError(QSerialPort::SerialPortError error)
@@ -266,7 +730,7 @@ void SerialController::handleError(QSerialPort::SerialPortError error)
         return;
 
     const QString message = tr("Serial error (%1): %2").arg(int(error)).arg(m_serial.errorString());
-    qWarning() << message;
+    PC_WARN(lcSerial) << message;
     emit connectionError(message);
     closePort();
 
@@ -276,175 +740,430 @@ void SerialController::handleError(QSerialPort::SerialPortError error)
 
 void SerialController::handleReconnectTimeout()
 {
-    if (!m_serial.isOpen())
+    if (!isPortOpen())
         openPort();
 }
 
-void SerialController::processFrame(quint8 cmd, const QByteArray &payload)
+bool SerialController::isPortOpen() const
 {
-    // Log ALL commands to see if mixer commands reach the switch
-    if (cmd == 0x21) {
-        qWarning() << "🎯🎯🎯 processFrame: CMD=0x21 (CmdMixerVolume) payload.size()=" << payload.size();
-    }
+    return m_threadedIo ? m_ioPortOpen : m_serial.isOpen();
+}
 
-    switch (cmd) {
-    case CmdHandshake:
-        if (payload == QByteArrayLiteral("PUSHCLONE_GUI")) {
-            qInfo() << "Handshake recibido";
-            setConnected(true);
-            setConnectionState(Connected);
-            sendFrame(CmdHandshakeReply, QByteArrayLiteral("PUSHCLONE_GUI"));
-        } else {
-            qWarning() << "Handshake payload inesperado" << payload;
-        }
-        break;
-    case CmdPing:
-        sendFrame(CmdPing);
-        break;
-    case CmdDisconnect:
-        qInfo() << "CMD_DISCONNECT recibido";
-        setConnected(false);
-        setConnectionState(WaitingHandshake);
-        break;
-    case CmdSelectedTrack:
-        if (payload.size() >= 1) {
-            int trackIndex = payload.at(0) & 0x7F;
-            qDebug() << "🎯 Selected track changed:" << trackIndex;
-            if (m_mixerModel) {
-                m_mixerModel->setSelectedTrackIndex(trackIndex);
-            }
+void SerialController::startIoThread()
+{
+    if (m_ioThread)
+        return;
+
+    m_ioThread = new QThread(this);
+    m_ioThread->setObjectName(QStringLiteral("SerialIo"));
+    m_ioWorker = new SerialIoWorker(&m_rxQueue, &m_rxDrainPending);
+    m_ioWorker->moveToThread(m_ioThread);
+    connect(m_ioThread, &QThread::finished, m_ioWorker, &QObject::deleteLater);
+
+    connect(m_ioWorker, &SerialIoWorker::framesAvailable, this, &SerialController::drainRxQueue, Qt::QueuedConnection);
+    connect(m_ioWorker, &SerialIoWorker::opened, this, &SerialController::handleIoOpened, Qt::QueuedConnection);
+    connect(m_ioWorker, &SerialIoWorker::openFailed, this, &SerialController::handleIoOpenFailed, Qt::QueuedConnection);
+    connect(m_ioWorker, &SerialIoWorker::errorOccurred, this, &SerialController::handleIoError, Qt::QueuedConnection);
+    connect(m_ioWorker, &SerialIoWorker::framingFallback, this, &SerialController::handleLinkLost, Qt::QueuedConnection);
+
+    m_ioThread->start();
+    m_ioThread->setPriority(QThread::HighPriority);
+}
+
+void SerialController::stopIoThread()
+{
+    if (!m_ioThread)
+        return;
+
+    m_ioWorker->requestStop();
+    QMetaObject::invokeMethod(m_ioWorker, &SerialIoWorker::close, Qt::BlockingQueuedConnection);
+    m_ioThread->quit();
+    m_ioThread->wait();
+    delete m_ioThread;
+    m_ioThread = nullptr;
+    m_ioWorker = nullptr;   // deleted by QThread::finished -> deleteLater
+    m_ioPortOpen = false;
+    m_ioOpenPending = false;
+
+    // Discard anything the worker queued before stopping
+    while (m_rxQueue.front())
+        m_rxQueue.pop();
+    m_rxDrainPending.store(false);
+}
+
+void SerialController::drainRxQueue()
+{
+    // Clear first: a frame queued after this point re-arms the wake-up
+    m_rxDrainPending.store(false);
+
+    const int depth = m_rxQueue.size();
+    if (depth == 0)
+        return;
+    m_rxQueueDepthMax = qMax(m_rxQueueDepthMax, depth);
+    ++m_rxDrains;
+
+    // Bounded by the depth observed at entry so a busy producer cannot
+    // starve the event loop; anything newer re-arms framesAvailable().
+    for (int i = 0; i < depth; ++i) {
+        SerialRxEvent *event = m_rxQueue.front();
+        if (!event)
+            break;
+
+        if (event->generation == m_ioGeneration) {
+            const qint64 latency = MonotonicClock::nowNs() - event->timestampNs;
+            m_handoffLatencyTotalNs += latency;
+            m_handoffLatencyMaxNs = qMax(m_handoffLatencyMaxNs, latency);
+            ++m_rxEventsDelivered;
+            m_rxTimestampNs = event->rxNs;
+            processFrame(event->cmd, event->view());
         }
-        break;
-    case CmdClipName:
-        handleClipName(payload);
-        break;
-    case CmdGridUpdate7bit:
-        handleGridUpdate7bit(payload);
-        break;
-    case CmdGridUpdate14bit:
-        handleGridUpdate14bit(payload);
-        break;
-    case CmdPadUpdate14bit:
-        handlePadUpdate14bit(payload);
-        break;
-    case CmdPadUpdate7bit:
-        handlePadUpdate7bit(payload);
-        break;
-    case CmdClipState:
-        handleClipState(payload);
-        break;
-    case CmdTrackName:
-        handleTrackName(payload);
-        break;
-    case CmdTrackColor:
-        handleTrackColor(payload);
-        break;
-    case CmdSceneName:
-        handleSceneName(payload);
-        break;
-    case CmdSceneColor:
-        handleSceneColor(payload);
-        break;
-    case CmdSceneTriggered:
-    case CmdSceneState:
-        handleSceneTriggered(payload);
-        break;
-    case CmdTransportPlay:
-    case CmdTransportRecord:
-    case CmdTransportLoop:
-    case CmdTransportTempo:
-    case CmdTransportState:
-        handleTransportCommand(cmd, payload);
-        break;
+        m_rxQueue.pop();
+    }
 
-    case CmdShiftState:
-        if (payload.size() >= 1) {
-            bool pressed = (payload[0] != 0);
-            if (m_shiftPressed != pressed) {
-                m_shiftPressed = pressed;
-                emit shiftPressedChanged();
-            }
+    m_rxTimestampNs = 0;
+
+    if (m_rxQueue.size() > 0 && !m_rxDrainPending.exchange(true))
+        QMetaObject::invokeMethod(this, &SerialController::drainRxQueue, Qt::QueuedConnection);
+}
+
+void SerialController::handleIoOpened()
+{
+    if (!m_ioOpenPending)
+        return; // closed again before the worker got to it
+
+    m_ioOpenPending = false;
+    m_ioPortOpen = true;
+    PC_INFO(lcSerial) << "Serial port opened on" << m_portName << "@" << m_baudRate << "(I/O thread)";
+    setConnectionState(WaitingHandshake);
+}
+
+void SerialController::handleIoOpenFailed(const QString &message)
+{
+    m_ioOpenPending = false;
+    PC_WARN(lcSerial) << message;
+    emit connectionError(message);
+    if (!m_reconnectTimer.isActive())
+        m_reconnectTimer.start();
+}
+
+void SerialController::handleIoError(const QString &message)
+{
+    PC_WARN(lcSerial) << message;
+    emit connectionError(message);
+    closePort();
+
+    if (!m_reconnectTimer.isActive())
+        m_reconnectTimer.start();
+}
+
+// ═══════════════════════════════════════════════════════════
+// DISPATCH
+// ═══════════════════════════════════════════════════════════
+
+template <typename Spec, void (SerialController::*Handler)(const typename Spec::Message &)>
+void SerialController::dispatchTyped(quint8, const PayloadView &payload)
+{
+    (this->*Handler)(Spec::decode(payload));
+}
+
+template <void (SerialController::*Handler)(const PayloadView &)>
+void SerialController::dispatchRaw(quint8, const PayloadView &payload)
+{
+    (this->*Handler)(payload);
+}
+
+const SerialController::DispatchTable &SerialController::dispatchTable()
+{
+    // 256-entry jump table built at compile time from the protocol schema.
+    // Unknown IDs accept only an impossible length, so they fail the
+    // length check without an extra branch on the hot path.
+    static constexpr DispatchTable table = []() {
+        DispatchTable t {};
+        for (DispatchEntry &entry : t) {
+            entry.minLen = 0xFFFF;
+            entry.maxLen = 0xFFFF;
         }
-        break;
-    
-    // Mixer commands
-    case CmdMixerVolume:
-        qWarning() << "⚡⚡⚡ CASE CmdMixerVolume REACHED!";
-        handleMixerVolume(payload);
-        break;
-    case CmdMixerPan:
-        handleMixerPan(payload);
-        break;
-    case CmdMixerMute:
-        handleMixerMute(payload);
-        break;
-    case CmdMixerSolo:
-        handleMixerSolo(payload);
-        break;
-    case CmdMixerArm:
-        handleMixerArm(payload);
-        break;
-    case CmdMixerSend:
-        handleMixerSend(payload);
-        break;
-    case CmdMixerMode:
-        handleMixerMode(payload);
-        break;
-    case CmdRingPosition:
-        handleRingPosition(payload);
-        break;
-    case CmdSessionRingMetadata:
-        handleSessionRingMetadata(payload);
-        break;
-    case CmdSessionRingClips:
-        handleSessionRingClips(payload);
-        break;
 
-    default:
-        // Por ahora solo registramos otros comandos para depuración.
-        qDebug() << "Frame recibido:" << Qt::hex << cmd << "len" << payload.size();
-        break;
+        auto route = [&t](auto spec, auto handler) {
+            using Spec = decltype(spec);
+            t[Spec::id] = { handler, Spec::minLen, Spec::maxLen };
+        };
+
+        route(Handshake(), &SerialController::dispatchRaw<&SerialController::handleHandshake>);
+        route(Ping(), &SerialController::dispatchRaw<&SerialController::handlePing>);
+        route(LinkCheck(), &SerialController::dispatchRaw<&SerialController::handleLinkCheck>);
+        route(Disconnect(), &SerialController::dispatchRaw<&SerialController::handleDisconnect>);
+        route(SelectedTrack(), &SerialController::dispatchTyped<SelectedTrack, &SerialController::handleSelectedTrack>);
+
+        route(ClipName(), &SerialController::dispatchTyped<ClipName, &SerialController::handleClipName>);
+        route(ClipState(), &SerialController::dispatchTyped<ClipState, &SerialController::handleClipState>);
+        route(GridUpdate7(), &SerialController::dispatchRaw<&SerialController::handleGridUpdate7bit>);
+        route(GridUpdate14(), &SerialController::dispatchRaw<&SerialController::handleGridUpdate14bit>);
+        route(PadUpdate7(), &SerialController::dispatchTyped<PadUpdate7, &SerialController::handlePadUpdate7bit>);
+        route(PadUpdate14(), &SerialController::dispatchRaw<&SerialController::handlePadUpdate14bit>);
+        route(GridDelta14(), &SerialController::dispatchTyped<GridDelta14, &SerialController::handleGridDelta14bit>);
+
+        route(TrackName(), &SerialController::dispatchTyped<TrackName, &SerialController::handleTrackName>);
+        route(TrackColor(), &SerialController::dispatchRaw<&SerialController::handleTrackColor>);
+        route(SceneName(), &SerialController::dispatchTyped<SceneName, &SerialController::handleSceneName>);
+        route(SceneColor(), &SerialController::dispatchRaw<&SerialController::handleSceneColor>);
+        route(SceneTriggered(), &SerialController::dispatchTyped<SceneTriggered, &SerialController::handleSceneTriggered>);
+        route(SceneState(), &SerialController::dispatchTyped<SceneState, &SerialController::handleSceneTriggered>);
+
+        route(TransportPlay(), &SerialController::handleTransportCommand);
+        route(TransportRecord(), &SerialController::handleTransportCommand);
+        route(TransportLoop(), &SerialController::handleTransportCommand);
+        route(TransportTempo(), &SerialController::handleTransportCommand);
+        route(TransportPosition(), &SerialController::handleTransportCommand);
+        route(TransportState(), &SerialController::handleTransportCommand);
+        route(ShiftState(), &SerialController::dispatchTyped<ShiftState, &SerialController::handleShiftState>);
+
+        route(MixerVolume(), &SerialController::dispatchTyped<MixerVolume, &SerialController::handleMixerVolume>);
+        route(MixerPan(), &SerialController::dispatchTyped<MixerPan, &SerialController::handleMixerPan>);
+        route(MixerMute(), &SerialController::dispatchTyped<MixerMute, &SerialController::handleMixerMute>);
+        route(MixerSolo(), &SerialController::dispatchTyped<MixerSolo, &SerialController::handleMixerSolo>);
+        route(MixerArm(), &SerialController::dispatchTyped<MixerArm, &SerialController::handleMixerArm>);
+        route(MixerSend(), &SerialController::dispatchTyped<MixerSend, &SerialController::handleMixerSend>);
+        route(MixerMode(), &SerialController::dispatchTyped<MixerMode, &SerialController::handleMixerMode>);
+        route(TrackMeters(), &SerialController::dispatchTyped<TrackMeters, &SerialController::handleTrackMeters>);
+
+        route(RingPosition(), &SerialController::dispatchTyped<RingPosition, &SerialController::handleRingPosition>);
+        route(SessionRingMetadata(), &SerialController::dispatchRaw<&SerialController::handleSessionRingMetadata>);
+        route(SessionRingClips(), &SerialController::dispatchRaw<&SerialController::handleSessionRingClips>);
+        route(PrefetchMetadata(), &SerialController::dispatchTyped<PrefetchMetadata, &SerialController::handlePrefetchMetadata>);
+        route(PrefetchClips(), &SerialController::dispatchTyped<PrefetchClips, &SerialController::handlePrefetchClips>);
+        return t;
+    }();
+
+    return table;
+}
+
+void SerialController::processFrame(quint8 cmd, const PayloadView &payload)
+{
+    const DispatchEntry &entry = dispatchTable()[cmd];
+
+    // minLen <= len <= maxLen as a single unsigned compare
+    if (quint32(payload.size() - entry.minLen) > quint32(entry.maxLen - entry.minLen)) {
+        TraceRing::instance().record(TraceRing::RxRejected, cmd, payload.data(), payload.size());
+        if (!entry.handler) {
+            ++m_rxUnknownCommands;
+            // Por ahora solo registramos otros comandos para depuración.
+            PC_DEBUG(lcProtocol) << "Frame recibido:" << Qt::hex << cmd << "len" << Qt::dec << payload.size();
+        } else {
+            ++m_rxCommandRejected[cmd];
+            PC_WARN(lcProtocol) << "Rejected cmd" << Qt::hex << cmd << "len" << Qt::dec << payload.size()
+                                << "expected" << entry.minLen << "-" << entry.maxLen;
+        }
+        return;
     }
+
+    ++m_rxCommandCounts[cmd];
+    if (!isBackgroundRx(cmd))
+        m_lastForegroundRxNs = m_rxTimestampNs;
+    m_latencyTracer.beginDispatch(cmd, m_rxTimestampNs, MonotonicClock::nowNs());
+    (this->*entry.handler)(cmd, payload);
+    m_latencyTracer.endDispatch();
+
+    if (NamePool::instance().wantsSweep())
+        reclaimNames();
 }
 
 void SerialController::sendFrame(quint8 cmd, const QByteArray &payload)
 {
-    if (!m_serial.isOpen()) {
-        qWarning() << "No serial port open to send frame";
+    sendFrame(cmd, reinterpret_cast<const quint8 *>(payload.constData()), int(payload.size()));
+}
+
+void SerialController::sendFrame(quint8 cmd, const quint8 *payload, int len)
+{
+    if (m_replay.isActive()) {
+        // Nothing to talk to: keep the frame in the trace only
+        TraceRing::instance().record(TraceRing::TxFrame, cmd, payload, len);
         return;
     }
 
-    const quint8 len = static_cast<quint8>(payload.size());
-    QByteArray frame;
-    frame.reserve(3 + payload.size() + 1);
-    frame.append(char(FrameHeader));
-    frame.append(char(cmd));
-    frame.append(char(len));
-    frame.append(payload);
-    frame.append(char(calculateChecksum(cmd, len, payload)));
-
-    qInfo().noquote() << QStringLiteral("[TX] FRAME cmd=0x%1 len=%2 payload=%3")
-                         .arg(cmd, 2, 16, QLatin1Char('0'))
-                         .arg(len)
-                         .arg(QString::fromLatin1(payload.toHex(' ')));
-
-    const qint64 written = m_serial.write(frame);
-    if (written != frame.size()) {
-        qWarning() << "Failed to write complete frame";
+    if (!isPortOpen()) {
+        PC_WARN(lcSerialTx) << "No serial port open to send frame";
+        return;
+    }
+
+    if (len > m_peerMaxPayload) {
+        PC_WARN(lcSerialTx) << "Frame cmd" << Qt::hex << cmd << Qt::dec << "len" << len
+                            << "exceeds peer max payload" << m_peerMaxPayload;
+        return;
+    }
+
+    TraceRing::instance().record(TraceRing::TxFrame, cmd, payload, len);
+    PC_DEBUG(lcSerialTx) << "TX cmd" << Qt::hex << cmd << "len" << Qt::dec << len;
+
+    m_txQueue.enqueue(cmd, payload, len);
+    scheduleTxFlush();
+}
+
+static_assert(int(MixerModel::SendDParameter) == int(MixerTxCoalescer::SendD),
+              "MixerModel::Parameter and MixerTxCoalescer::Parameter must match");
+
+void SerialController::queueMixerParameter(int track, int parameter, float value)
+{
+    const quint16 value14 = MixerValueTables::fromNormalized(value);
+    if (!m_mixerTx.update(track, parameter, value14) || !m_mixerTx.hasPending())
+        return;
+
+    // Leading edge goes out right away; moves within the next period wait
+    // for the timer and only their last value is sent
+    if (!m_mixerTxTimer.isActive()) {
+        flushMixerTx();
+        m_mixerTxTimer.start();
+    }
+}
+
+void SerialController::flushMixerTx()
+{
+    if (!m_mixerTx.hasPending()) {
+        m_mixerTxTimer.stop();   // a quiet period ends the burst
+        return;
+    }
+
+    if (!isPortOpen() && !m_replay.isActive()) {
+        m_mixerTx.clear();
+        return;
     }
-    m_serial.flush();
 
-    // Opcional: volcar los bytes exactos que salieron (incluyendo header y checksum)
-    qInfo().noquote() << QStringLiteral("[TX] RAW %1")
-                         .arg(QString::fromLatin1(frame.toHex(' ')));
+    m_mixerTx.flush([this](int track, int parameter, quint16 value) {
+        const quint8 msb = quint8((value >> 7) & 0x7F);
+        const quint8 lsb = quint8(value & 0x7F);
+        switch (parameter) {
+        case MixerTxCoalescer::Volume: {
+            const quint8 payload[] = { quint8(track), msb, lsb };
+            sendFrame(CmdMixerVolume, payload, sizeof(payload));
+            break;
+        }
+        case MixerTxCoalescer::Pan: {
+            const quint8 payload[] = { quint8(track), msb, lsb };
+            sendFrame(CmdMixerPan, payload, sizeof(payload));
+            break;
+        }
+        default: {
+            const quint8 payload[] = { quint8(track), quint8(parameter - MixerTxCoalescer::SendA), msb, lsb };
+            sendFrame(CmdMixerSend, payload, sizeof(payload));
+            break;
+        }
+        }
+    });
 }
 
-quint8 SerialController::calculateChecksum(quint8 cmd, quint8 len, const QByteArray &payload) const
+void SerialController::scheduleTxFlush()
 {
-    quint8 checksum = cmd ^ len;
-    for (const char byte : payload)
-        checksum ^= quint8(byte);
-    return checksum;
+    if (m_txFlushScheduled)
+        return;
+    m_txFlushScheduled = true;
+    QMetaObject::invokeMethod(this, &SerialController::flushTxQueue, Qt::QueuedConnection);
+}
+
+void SerialController::flushTxQueue()
+{
+    m_txFlushScheduled = false;
+    if (m_txQueue.isEmpty() || m_linkSwitchPending)
+        return;   // held frames go out once the new baud rate is confirmed
+
+    if (!isPortOpen()) {
+        m_txQueue.clear();
+        return;
+    }
+
+    ++m_txBatches;
+
+    if (m_threadedIo) {
+        // One queued call per batch; the worker times the write itself
+        const QByteArray batch = m_txQueue.take();
+        SerialIoWorker *worker = m_ioWorker;
+        QMetaObject::invokeMethod(m_ioWorker, [worker, batch]() { worker->write(batch); },
+                                  Qt::QueuedConnection);
+        return;
+    }
+
+    // No flush(): QSerialPort drains its write buffer from the event loop
+    const qint64 start = MonotonicClock::nowNs();
+    const qint64 written = m_serial.write(m_txQueue.buffer());
+    const qint64 stallNs = MonotonicClock::nowNs() - start;
+    ++m_txWrites;
+    m_txWriteStallTotalNs += stallNs;
+    m_txWriteStallMaxNs = qMax(m_txWriteStallMaxNs, stallNs);
+
+    if (written < 0) {
+        PC_WARN(lcSerialTx) << "Serial write failed:" << m_serial.errorString();
+        m_txQueue.clear();
+        return;
+    }
+    // Whatever was not accepted stays queued until bytesWritten()
+    m_txQueue.consume(written);
+}
+
+void SerialController::setFramingVersion(SerialFrameParser::FramingVersion version)
+{
+    if (m_txQueue.framingVersion() != version)
+        PC_INFO(lcProtocol) << "Framing v" << int(version);
+
+    m_txQueue.setFramingVersion(version);
+    m_rxParser.setFramingVersion(version);
+    if (m_ioWorker) {
+        // Queued ahead of the next TX batch, so the worker parses the
+        // peer's first frame in the new framing
+        SerialIoWorker *worker = m_ioWorker;
+        QMetaObject::invokeMethod(m_ioWorker, [worker, version]() { worker->setFramingVersion(version); },
+                                  Qt::QueuedConnection);
+    }
+}
+
+void SerialController::applyLinkBaudRate(int baud)
+{
+    if (m_threadedIo) {
+        if (m_ioWorker) {
+            SerialIoWorker *worker = m_ioWorker;
+            QMetaObject::invokeMethod(m_ioWorker, [worker, baud]() { worker->setBaudRate(baud); },
+                                      Qt::QueuedConnection);
+        }
+    } else if (m_serial.isOpen()) {
+        if (!m_serial.setBaudRate(baud))
+            PC_WARN(lcSerial) << "Could not set baud rate" << baud << m_serial.errorString();
+        m_rxParser.clear();   // bytes straddling the switch are garbage at either rate
+    }
+
+    if (m_linkBaudRate == baud)
+        return;
+    PC_INFO(lcSerial) << "Link baud rate" << m_linkBaudRate << "->" << baud;
+    m_linkBaudRate = baud;
+    emit linkBaudRateChanged();
+}
+
+void SerialController::resetLinkCaps()
+{
+    m_linkCheckTimer.stop();
+    m_linkSwitchPending = false;
+    m_linkFeatures = 0;
+    m_peerMaxPayload = SerialFrameParser::MaxPayloadV1;
+    if (m_linkBaudRate != m_baudRate)
+        applyLinkBaudRate(m_baudRate);
+}
+
+void SerialController::handleLinkLost()
+{
+    PC_WARN(lcProtocol) << "Enlace perdido, esperando handshake a" << m_baudRate << "baud";
+    m_txQueue.clear();
+    setFramingVersion(SerialFrameParser::FramingV1);
+    resetLinkCaps();
+    setConnected(false);
+    setConnectionState(WaitingHandshake);
+}
+
+void SerialController::handleLinkCheckTimeout()
+{
+    if (!m_linkSwitchPending)
+        return;
+
+    PC_WARN(lcProtocol) << "Sin CMD_LINK_CHECK a" << m_linkBaudRate << "baud, no se vuelve a intentar en este puerto";
+    m_baudSwitchDisabled = true;
+    ++m_baudFallbacks;
+    handleLinkLost();
 }
 
 void SerialController::setConnected(bool value)
@@ -463,15 +1182,167 @@ void SerialController::setConnectionState(ConnectionState state)
     m_connectionState = state;
     emit connectionStateChanged();
 
+    if (state == Connected && m_pingIntervalMs > 0) {
+        m_pingTimer.start();
+    } else if (state != Connected) {
+        // Replies can't arrive any more: forget them without counting losses
+        m_pingTimer.stop();
+        m_pendingPings.fill(PendingPing());
+        m_meterStore->clear();   // no stale levels frozen on screen
+        m_sessionCache.clear();  // the set may differ after reconnecting
+        if (NamePool::instance().insertsSinceSweep() > 0)
+            reclaimNames();      // names only the old set used
+        m_ringPrefetcher.clear();
+        m_prefetchTimer.stop();
+    }
+}
+
+void SerialController::handleHandshake(const PayloadView &payload)
+{
+    // Capabilities and reply layout: see Protocol::LinkCaps. The handshake
+    // and its reply always travel in v1 at the base baud rate.
+    LinkCaps offered;
+    if (!LinkCaps::decode(payload, &offered)) {
+        PC_WARN(lcProtocol) << "Handshake payload inesperado" << payload.toByteArray();
+        return;
+    }
+
+    PC_INFO(lcProtocol) << "Handshake recibido: framing v" << offered.framing << "features" << offered.features
+                        << "maxPayload" << offered.maxPayload << "baud" << offered.baudRate;
+    setConnected(true);
+    setConnectionState(Connected);
+    setFramingVersion(SerialFrameParser::FramingV1);
+    resetLinkCaps();
+
+    LinkCaps agreed;
+    agreed.form = offered.form;
+    agreed.framing = quint8(qBound<int>(SerialFrameParser::FramingV1, offered.framing, SerialFrameParser::FramingV2));
+    const bool v2 = agreed.framing == SerialFrameParser::FramingV2;
+    agreed.features = offered.features & (FeatureGridDelta | FeaturePingEcho | FeatureTrackMeters
+                                         | FeatureRingPrefetch);
+    agreed.maxPayload = quint16(v2 ? SerialFrameParser::MaxPayload : SerialFrameParser::MaxPayloadV1);
+
+    int targetBaud = 0;
+    if (offered.form == LinkCaps::Full) {
+        if (offered.baudRate > quint32(m_baudRate) && m_maxBaudRate > m_baudRate
+            && !m_baudSwitchDisabled && !m_replay.isActive())
+            targetBaud = int(qMin(offered.baudRate, quint32(m_maxBaudRate)));
+        m_linkFeatures = agreed.features;
+        m_peerMaxPayload = qMin<int>(offered.maxPayload, agreed.maxPayload);
+    }
+    agreed.baudRate = quint32(targetBaud);
+
+    sendFrame(CmdHandshakeReply, agreed.encode());
+    setFramingVersion(SerialFrameParser::FramingVersion(agreed.framing));
+
+    if (targetBaud > 0) {
+        // The reply leaves at the current rate; everything after it waits
+        // for CMD_LINK_CHECK at the new one.
+        flushTxQueue();
+        if (!m_threadedIo && m_serial.isOpen())
+            m_serial.flush();
+        m_linkSwitchPending = true;
+        ++m_baudSwitches;
+        QTimer::singleShot(BaudSwitchDelayMs, this, [this, targetBaud]() {
+            if (m_linkSwitchPending)
+                applyLinkBaudRate(targetBaud);
+        });
+        m_linkCheckTimer.start();
+    }
+}
+
+void SerialController::handlePing(const PayloadView &payload)
+{
+    // Empty: the firmware's keep-alive, echoed as before. Two bytes: the
+    // echo of one of our pings; never sent back, or the two would loop.
+    if (payload.size() != 2) {
+        sendFrame(CmdPing);
+        return;
+    }
+
+    const quint16 seq = quint16((payload.at(0) & 0x7F) << 7 | (payload.at(1) & 0x7F));
+    PendingPing &slot = m_pendingPings[seq % PingSlots];
+    if (slot.sentNs == 0 || slot.seq != seq) {
+        ++m_pingsUnmatched;   // late reply to a slot already reused, or stale
+        return;
+    }
+
+    const qint64 rttNs = MonotonicClock::nowNs() - slot.sentNs;
+    slot.sentNs = 0;
+    m_pingRtt.record(quint64(qMax<qint64>(0, rttNs)) / 1000);
+    emit pingStatsChanged();
+}
+
+void SerialController::sendPing()
+{
+    // Older firmware answers any ping with an empty one, which we'd echo
+    // forever; held frames would sit in the queue and inflate the RTT.
+    if (!(m_linkFeatures & FeaturePingEcho) || m_linkSwitchPending || m_replay.isActive())
+        return;
+
+    const quint16 seq = m_pingSeq;
+    m_pingSeq = (m_pingSeq + 1) & 0x3FFF;
+
+    PendingPing &slot = m_pendingPings[seq % PingSlots];
+    if (slot.sentNs != 0) {
+        // Still unanswered after PingSlots intervals
+        ++m_pingsLost;
+        emit pingStatsChanged();
+    }
+    slot.seq = seq;
+    slot.sentNs = MonotonicClock::nowNs();
+    ++m_pingsSent;
+
+    const quint8 payload[2] = { quint8((seq >> 7) & 0x7F), quint8(seq & 0x7F) };
+    sendFrame(CmdPing, payload, 2);
 }
 
-void SerialController::handleClipName(const QByteArray &payload)
+void SerialController::handleLinkCheck(const PayloadView &payload)
 {
-    if (payload.size() < 2 || !m_clipModel)
+    // Echo every check: the firmware repeats them until one comes back
+    sendFrame(CmdLinkCheck, payload.data(), payload.size());
+    if (!m_linkSwitchPending)
         return;
-    const int absoluteTrack = static_cast<quint8>(payload.at(0));
-    const int absoluteScene = static_cast<quint8>(payload.at(1));
-    const QString name = readLengthPrefixedString(payload, 2);
+
+    PC_INFO(lcProtocol) << "Enlace confirmado a" << m_linkBaudRate << "baud";
+    m_linkCheckTimer.stop();
+    m_linkSwitchPending = false;
+    scheduleTxFlush();
+}
+
+void SerialController::handleDisconnect(const PayloadView &)
+{
+    PC_INFO(lcProtocol) << "CMD_DISCONNECT recibido";
+    setFramingVersion(SerialFrameParser::FramingV1);
+    setConnected(false);
+    setConnectionState(WaitingHandshake);
+}
+
+void SerialController::handleSelectedTrack(const Protocol::SelectedTrack::Message &msg)
+{
+    const auto [trackIndex] = msg;
+    PC_DEBUG(lcProtocol) << "🎯 Selected track changed:" << trackIndex;
+    if (m_mixerModel) {
+        m_mixerModel->setSelectedTrackIndex(trackIndex);
+    }
+}
+
+void SerialController::handleShiftState(const Protocol::ShiftState::Message &msg)
+{
+    const bool pressed = std::get<0>(msg) != 0;
+    if (m_shiftPressed != pressed) {
+        m_shiftPressed = pressed;
+        emit shiftPressedChanged();
+    }
+}
+
+void SerialController::handleClipName(const Protocol::ClipName::Message &msg)
+{
+    if (!m_clipModel)
+        return;
+    const auto &[absoluteTrack, absoluteScene, nameBytes] = msg;
+    const NamePool::Handle name = NamePool::instance().intern(nameBytes.constData(), nameBytes.size());
+    m_sessionCache.setClipName(absoluteTrack, absoluteScene, name);
 
     // Convert to relative indices
     const int relativeTrack = absoluteTrack - m_ringTrackOffset;
@@ -484,66 +1355,97 @@ void SerialController::handleClipName(const QByteArray &payload)
     }
 }
 
-void SerialController::handleGridUpdate7bit(const QByteArray &payload)
+void SerialController::handleGridUpdate7bit(const PayloadView &payload)
 {
-    if (!m_clipModel || payload.size() < 3)
+    if (!m_clipModel)
         return;
-    const int padCount = payload.size() / 3;
-    const int totalRows = m_clipModel->rowCount();
-    for (int i = 0; i < padCount && i < totalRows; ++i) {
-        const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + i * 3);
-        updatePadColor(i % 8, i / 8, colorFrom7(colorData));
-    }
+    const int padCount = qMin(payload.size() / 3, ClipGridModel::Cells);
+    std::array<QRgb, ClipGridModel::Cells> colors;
+    ColorBatch::decodeRgb7(payload.data(), padCount, colors.data());
+    applyGridColors(padCount, colors.data());
 }
 
-void SerialController::handleGridUpdate14bit(const QByteArray &payload)
+void SerialController::handleGridUpdate14bit(const PayloadView &payload)
 {
-    if (!m_clipModel || payload.size() < 6)
+    if (!m_clipModel)
         return;
-    const int padCount = payload.size() / 6;
-    const int totalRows = m_clipModel->rowCount();
-    for (int i = 0; i < padCount && i < totalRows; ++i) {
-        const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + i * 6);
-        updatePadColor(i % 8, i / 8, colorFrom14(colorData));
-    }
+    const int padCount = qMin(payload.size() / 6, ClipGridModel::Cells);
+    std::array<QRgb, ClipGridModel::Cells> colors;
+    ColorBatch::decodeRgb14(payload.data(), padCount, colors.data());
+    applyGridColors(padCount, colors.data());
+}
+
+void SerialController::applyGridColors(int padCount, const QRgb *colors)
+{
+    // Pads 0..padCount-1 in row order (pad = scene * 8 + track)
+    for (int pad = 0; pad < padCount; ++pad)
+        m_sessionCache.setClipColor(pad % 8 + m_ringTrackOffset, pad / 8 + m_ringSceneOffset, colors[pad]);
+    const quint32 mask = padCount >= 32 ? 0xFFFFFFFFu : (1u << padCount) - 1;
+    m_clipModel->setClipColors(mask, colors);
 }
 
-void SerialController::handlePadUpdate14bit(const QByteArray &payload)
+void SerialController::handlePadUpdate14bit(const PayloadView &payload)
 {
-    if (!m_clipModel || payload.size() < 7)
+    if (!m_clipModel)
         return;
 
     int track = -1;
     int scene = -1;
     int offset = 1;
 
-    if (payload.size() >= 8 &&
-        static_cast<quint8>(payload.at(0)) < 8 &&
-        static_cast<quint8>(payload.at(1)) < 4) {
-        track = static_cast<quint8>(payload.at(0));
-        scene = static_cast<quint8>(payload.at(1));
+    // 8 bytes: [track, scene, rgb14]; 7 bytes: [padIndex, rgb14]
+    if (payload.size() >= 8 && payload.at(0) < 8 && payload.at(1) < 4) {
+        track = payload.at(0);
+        scene = payload.at(1);
         offset = 2;
     } else {
-        const int padIndex = static_cast<quint8>(payload.at(0));
+        const int padIndex = payload.at(0);
         track = padIndex % 8;
         scene = padIndex / 8;
     }
 
-    if (payload.size() < offset + 6)
+    if (payload.size() < offset + Rgb14::Size)
         return;
 
-    const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + offset);
-    updatePadColor(track, scene, colorFrom14(colorData));
+    updatePadColor(track, scene, colorFrom14(payload.data() + offset));
 }
 
-void SerialController::handlePadUpdate7bit(const QByteArray &payload)
+void SerialController::handleGridDelta14bit(const Protocol::GridDelta14::Message &msg)
 {
-    if (!m_clipModel || payload.size() < 5)
+    const auto &[mask, colorData] = msg;
+    const int pads = int(qPopulationCount(mask));
+    if (colorData.size() != pads * Rgb14::Size) {
+        ++m_rxCommandRejected[CmdGridDelta14bit];
+        PC_WARN(lcProtocol) << "Grid delta: mask has" << pads << "pads but" << colorData.size() << "color bytes";
         return;
+    }
 
-    const int absoluteTrack = static_cast<quint8>(payload.at(0));
-    const int absoluteScene = static_cast<quint8>(payload.at(1));
-    const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + 2);
+    ++m_gridDeltaFrames;
+    m_gridDeltaPads += quint64(pads);
+    m_gridDeltaBytesSaved += quint64(32 * Rgb14::Size - (Mask32::Size + colorData.size()));
+
+    if (!m_clipModel)
+        return;
+
+    // Colors arrive in ascending pad order, one per set bit: decode them
+    // packed, then spread them out to their pads
+    std::array<QRgb, 32> packed;
+    ColorBatch::decodeRgb14(colorData.data(), pads, packed.data());
+    std::array<QRgb, 32> colors;
+    int next = 0;
+    for (quint32 bits = mask; bits; bits &= bits - 1) {
+        const int pad = int(qCountTrailingZeroBits(bits));
+        colors[pad] = packed[next++];
+        m_sessionCache.setClipColor(pad % 8 + m_ringTrackOffset, pad / 8 + m_ringSceneOffset, colors[pad]);
+    }
+    m_clipModel->setClipColors(mask, colors.data());
+}
+
+void SerialController::handlePadUpdate7bit(const Protocol::PadUpdate7::Message &msg)
+{
+    if (!m_clipModel)
+        return;
+    const auto &[absoluteTrack, absoluteScene, rgb] = msg;
 
     // Convert to relative indices
     const int relativeTrack = absoluteTrack - m_ringTrackOffset;
@@ -552,17 +1454,18 @@ void SerialController::handlePadUpdate7bit(const QByteArray &payload)
     // Only update if clip is within visible session ring (8x4)
     if (relativeTrack >= 0 && relativeTrack < 8 &&
         relativeScene >= 0 && relativeScene < 4) {
-        updatePadColor(relativeTrack, relativeScene, colorFrom7(colorData));
+        updatePadColor(relativeTrack, relativeScene, QColor(rgb));
+    } else {
+        m_sessionCache.setClipColor(absoluteTrack, absoluteScene, rgb);
     }
 }
 
-void SerialController::handleClipState(const QByteArray &payload)
+void SerialController::handleClipState(const Protocol::ClipState::Message &msg)
 {
-    if (!m_clipModel || payload.size() < 3)
+    if (!m_clipModel)
         return;
-    const int absoluteTrack = static_cast<quint8>(payload.at(0));
-    const int absoluteScene = static_cast<quint8>(payload.at(1));
-    const int state = static_cast<quint8>(payload.at(2));
+    const auto &[absoluteTrack, absoluteScene, state, colorData] = msg;
+    m_sessionCache.setClipState(absoluteTrack, absoluteScene, state);
 
     // Convert to relative indices
     const int relativeTrack = absoluteTrack - m_ringTrackOffset;
@@ -571,29 +1474,34 @@ void SerialController::handleClipState(const QByteArray &payload)
     // Only update if clip is within visible session ring (8x4)
     if (relativeTrack >= 0 && relativeTrack < 8 &&
         relativeScene >= 0 && relativeScene < 4) {
+        // State + color land in one dataChanged
+        ClipGridModel::Batch batch(m_clipModel);
         m_clipModel->setClipState(relativeTrack, relativeScene, state);
 
-        if (payload.size() >= 9) {
-            const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + 3);
-            updatePadColor(relativeTrack, relativeScene, colorFrom14(colorData));
-        }
+        // Optional trailing RGB14
+        if (colorData.size() >= Rgb14::Size)
+            updatePadColor(relativeTrack, relativeScene, colorFrom14(colorData.data()));
+    } else if (colorData.size() >= Rgb14::Size) {
+        m_sessionCache.setClipColor(absoluteTrack, absoluteScene, rgbFrom14(colorData.data()));
     }
 }
 
 void SerialController::updatePadColor(int track, int scene, const QColor &color)
 {
-    if (!m_clipModel)
+    // This method now expects RELATIVE indices (already converted by callers).
+    // Outside the ring the absolute cell would belong to another window
+    if (track < 0 || track >= ClipGridModel::Tracks || scene < 0 || scene >= ClipGridModel::Scenes)
         return;
-    // This method now expects RELATIVE indices (already converted by callers)
-    m_clipModel->setClipColor(track, scene, color);
+    m_sessionCache.setClipColor(track + m_ringTrackOffset, scene + m_ringSceneOffset, color.rgb());
+    if (m_clipModel)
+        m_clipModel->setClipColor(track, scene, color);
 }
 
-void SerialController::handleTrackName(const QByteArray &payload)
+void SerialController::handleTrackName(const Protocol::TrackName::Message &msg)
 {
-    if (payload.size() < 1)
-        return;
-    const int absoluteTrack = static_cast<quint8>(payload.at(0));
-    const QString name = readLengthPrefixedString(payload, 1);
+    const auto &[absoluteTrack, nameBytes] = msg;
+    const NamePool::Handle name = NamePool::instance().intern(nameBytes.constData(), nameBytes.size());
+    m_sessionCache.setTrackName(absoluteTrack, name);
 
     // Convert absolute track index to relative (based on session ring offset)
     const int relativeTrack = absoluteTrack - m_ringTrackOffset;
@@ -606,19 +1514,18 @@ void SerialController::handleTrackName(const QByteArray &payload)
 
     // MixerModel uses absolute indices (8 tracks total, independent of ring)
     if (m_mixerModel)
-        m_mixerModel->setTrackName(absoluteTrack, name);
+        m_mixerModel->setTrackName(absoluteTrack, NamePool::instance().name(name));
 
     scheduleTrackCleanup(absoluteTrack);
 }
 
-void SerialController::handleTrackColor(const QByteArray &payload)
+void SerialController::handleTrackColor(const PayloadView &payload)
 {
-    if (payload.size() < 4)
-        return;
-    const int absoluteTrack = static_cast<quint8>(payload.at(0));
-    const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + 1);
-    QColor color = (payload.size() >= 7) ? colorFrom14(colorData)
-                                         : colorFrom7(colorData);
+    const auto [absoluteTrack, rgb] = payload.size() >= IndexRgb14::fixedSize
+                                          ? IndexRgb14::decode(payload)
+                                          : IndexRgb7::decode(payload);
+    const QColor color(rgb);
+    m_sessionCache.setTrackColor(absoluteTrack, rgb);
 
     // Convert absolute track index to relative (based on session ring offset)
     const int relativeTrack = absoluteTrack - m_ringTrackOffset;
@@ -634,38 +1541,38 @@ void SerialController::handleTrackColor(const QByteArray &payload)
         m_mixerModel->setTrackColor(absoluteTrack, color);
 }
 
-void SerialController::handleSceneName(const QByteArray &payload)
+void SerialController::handleSceneName(const Protocol::SceneName::Message &msg)
 {
-    if (!m_sceneModel || payload.size() < 1)
+    if (!m_sceneModel)
         return;
-    const int scene = static_cast<quint8>(payload.at(0));
-    const QString name = QString::fromUtf8(payload.constData() + 1, payload.size() - 1);
+    const auto &[scene, nameBytes] = msg;
+    const NamePool::Handle name = NamePool::instance().intern(nameBytes.constData(), nameBytes.size());
+    m_sessionCache.setSceneName(scene + m_ringSceneOffset, name);
     m_sceneModel->setSceneName(scene, name);
 }
 
-void SerialController::handleSceneColor(const QByteArray &payload)
+void SerialController::handleSceneColor(const PayloadView &payload)
 {
-    if (!m_sceneModel || payload.size() < 4)
+    if (!m_sceneModel)
         return;
-    const int scene = static_cast<quint8>(payload.at(0));
-    const quint8 *colorData = reinterpret_cast<const quint8 *>(payload.constData() + 1);
-    QColor color = (payload.size() >= 7) ? colorFrom14(colorData)
-                                         : colorFrom7(colorData);
-    m_sceneModel->setSceneColor(scene, color);
+    const auto [scene, rgb] = payload.size() >= IndexRgb14::fixedSize
+                                  ? IndexRgb14::decode(payload)
+                                  : IndexRgb7::decode(payload);
+    m_sessionCache.setSceneColor(scene + m_ringSceneOffset, rgb);
+    m_sceneModel->setSceneColor(scene, QColor(rgb));
 }
 
-void SerialController::handleSceneTriggered(const QByteArray &payload)
+void SerialController::handleSceneTriggered(const Protocol::SceneTriggered::Message &msg)
 {
-    if (!m_sceneModel || payload.size() < 2)
+    if (!m_sceneModel)
         return;
-    const int scene = static_cast<quint8>(payload.at(0));
-    const bool triggered = static_cast<quint8>(payload.at(1)) != 0;
-    m_sceneModel->setSceneTriggered(scene, triggered);
+    const auto [scene, triggered] = msg;
+    m_sceneModel->setSceneTriggered(scene, triggered != 0);
 }
 
-void SerialController::handleTransportCommand(quint8 cmd, const QByteArray &payload)
+void SerialController::handleTransportCommand(quint8 cmd, const PayloadView &payload)
 {
-    auto boolValue = [&](const QByteArray &data) -> bool {
+    auto boolValue = [&](const PayloadView &data) -> bool {
         if (data.isEmpty())
             return false;
         return static_cast<quint8>(data.at(0)) != 0;
@@ -690,55 +1597,49 @@ void SerialController::handleTransportCommand(quint8 cmd, const QByteArray &payl
             emit transportStateChanged();
         }
         break;
-    case CmdTransportTempo:
-        if (payload.size() >= 2) {
-            // BPM is sent as 14-bit value (like mixer params)
-            const quint8 msb = payload.at(0) & 0x7F;
-            const quint8 lsb = payload.at(1) & 0x7F;
-            const int value14bit = decode14Bit(msb, lsb);
-            const double tempo = value14bit / 10.0;
-
-            qWarning() << "🎼 BPM Debug: MSB=" << msb << "LSB=" << lsb
-                      << "14bit=" << value14bit << "BPM=" << tempo;
-
-            if (!qFuzzyCompare(tempo, m_transportTempo)) {
-                m_transportTempo = tempo;
-                emit transportTempoChanged();
-            }
+    case CmdTransportTempo: {
+        // BPM is sent as 14-bit value (like mixer params)
+        const auto [value14bit] = TransportTempo::decode(payload);
+        const double tempo = value14bit / 10.0;
+
+        PC_DEBUG(lcProtocol) << "🎼 Tempo: 14bit=" << value14bit << "BPM=" << tempo;
+
+        if (!qFuzzyCompare(tempo, m_transportTempo)) {
+            m_transportTempo = tempo;
+            emit transportTempoChanged();
         }
         break;
-    case CmdTransportPosition:
-        if (!payload.isEmpty()) {
-            const QString position = QString::fromUtf8(payload);
-            if (m_transportPosition != position) {
-                m_transportPosition = position;
-                emit transportPositionChanged();
-            }
+    }
+    case CmdTransportPosition: {
+        const auto [position] = TransportPosition::decode(payload);
+        if (m_transportPosition != position) {
+            m_transportPosition = position;
+            emit transportPositionChanged();
         }
         break;
-    case CmdTransportState:
-        if (payload.size() >= 1) {
-            const quint8 flags = static_cast<quint8>(payload.at(0));
-            bool playing = flags & 0x01;
-            bool recording = flags & 0x02;
-            bool loop = flags & 0x04;
-            bool changed = false;
-            if (m_transportPlaying != playing) {
-                m_transportPlaying = playing;
-                changed = true;
-            }
-            if (m_transportRecording != recording) {
-                m_transportRecording = recording;
-                changed = true;
-            }
-            if (m_transportLoop != loop) {
-                m_transportLoop = loop;
-                changed = true;
-            }
-            if (changed)
-                emit transportStateChanged();
+    }
+    case CmdTransportState: {
+        const auto [flags] = TransportState::decode(payload);
+        bool playing = flags & 0x01;
+        bool recording = flags & 0x02;
+        bool loop = flags & 0x04;
+        bool changed = false;
+        if (m_transportPlaying != playing) {
+            m_transportPlaying = playing;
+            changed = true;
         }
+        if (m_transportRecording != recording) {
+            m_transportRecording = recording;
+            changed = true;
+        }
+        if (m_transportLoop != loop) {
+            m_transportLoop = loop;
+            changed = true;
+        }
+        if (changed)
+            emit transportStateChanged();
         break;
+    }
     default:
         break;
     }
@@ -778,120 +1679,86 @@ void SerialController::handleTrackBatchTimeout()
 // MIXER HANDLERS
 // ═══════════════════════════════════════════════════════════
 
-void SerialController::handleMixerVolume(const QByteArray &payload)
+void SerialController::handleMixerVolume(const Protocol::MixerVolume::Message &msg)
 {
-    qWarning() << "🔊🔊🔊 handleMixerVolume CALLED - payload size:" << payload.size();
-
-    if (!m_mixerModel) {
-        qWarning() << "❌ handleMixerVolume: m_mixerModel is NULL!";
+    if (!m_mixerModel)
         return;
-    }
 
-    if (payload.size() < 3) {
-        qWarning() << "❌ handleMixerVolume: payload too short:" << payload.size();
-        return;
-    }
+    const auto [trackIndex, value14bit] = msg;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const quint8 valueMsb = payload[1] & 0x7F;
-    const quint8 valueLsb = payload[2] & 0x7F;
+    // Raw 14-bit straight in: float and label come from the lookup tables
+    m_mixerModel->setTrackVolume14(trackIndex, value14bit);
 
-    qWarning() << "   Parsed: track=" << trackIndex << "MSB=" << valueMsb << "LSB=" << valueLsb;
-
-    // Decode 14-bit value to 0.0-1.0
-    const int value14bit = decode14Bit(valueMsb, valueLsb);
-    const float volume = qBound(0.0f, value14bit / 16383.0f, 1.0f);
-
-    qWarning() << "   Decoded: 14bit=" << value14bit << "volume=" << volume;
-    qWarning() << "   MixerModel totalTracks=" << m_mixerModel->totalTracks();
-
-    m_mixerModel->setTrackVolume(trackIndex, volume);
-
-    qWarning() << "✅ Mixer Volume:" << trackIndex << "→" << volume;
+    PC_DEBUG(lcMixer) << "Mixer Volume:" << trackIndex << "→" << value14bit << "(14bit)";
 }
 
-void SerialController::handleMixerPan(const QByteArray &payload)
+void SerialController::handleMixerPan(const Protocol::MixerPan::Message &msg)
 {
-    if (!m_mixerModel || payload.size() < 3)
+    if (!m_mixerModel)
         return;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const quint8 valueMsb = payload[1] & 0x7F;
-    const quint8 valueLsb = payload[2] & 0x7F;
-    
-    // Decode 14-bit value to 0.0-1.0 (0.5 = center)
-    const int value14bit = decode14Bit(valueMsb, valueLsb);
-    const float pan = qBound(0.0f, value14bit / 16383.0f, 1.0f);
-    
-    m_mixerModel->setTrackPan(trackIndex, pan);
-    
-    qDebug() << "Mixer Pan:" << trackIndex << "→" << pan;
+    const auto [trackIndex, value14bit] = msg;
+
+    // 14-bit, 8192 = center
+    m_mixerModel->setTrackPan14(trackIndex, value14bit);
+
+    PC_DEBUG(lcMixer) << "Mixer Pan:" << trackIndex << "→" << value14bit << "(14bit)";
 }
 
-void SerialController::handleMixerMute(const QByteArray &payload)
+void SerialController::handleMixerMute(const Protocol::MixerMute::Message &msg)
 {
-    if (!m_mixerModel || payload.size() < 2)
+    if (!m_mixerModel)
         return;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const bool muted = (payload[1] & 0x7F) != 0;
+    const auto [trackIndex, value] = msg;
+    const bool muted = value != 0;
     
     m_mixerModel->setTrackMuted(trackIndex, muted);
     
-    qDebug() << "Mixer Mute:" << trackIndex << "→" << muted;
+    PC_DEBUG(lcMixer) << "Mixer Mute:" << trackIndex << "→" << muted;
 }
 
-void SerialController::handleMixerSolo(const QByteArray &payload)
+void SerialController::handleMixerSolo(const Protocol::MixerSolo::Message &msg)
 {
-    if (!m_mixerModel || payload.size() < 2)
+    if (!m_mixerModel)
         return;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const bool solo = (payload[1] & 0x7F) != 0;
+    const auto [trackIndex, value] = msg;
+    const bool solo = value != 0;
     
     m_mixerModel->setTrackSolo(trackIndex, solo);
     
-    qDebug() << "Mixer Solo:" << trackIndex << "→" << solo;
+    PC_DEBUG(lcMixer) << "Mixer Solo:" << trackIndex << "→" << solo;
 }
 
-void SerialController::handleMixerArm(const QByteArray &payload)
+void SerialController::handleMixerArm(const Protocol::MixerArm::Message &msg)
 {
-    if (!m_mixerModel || payload.size() < 2)
+    if (!m_mixerModel)
         return;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const bool armed = (payload[1] & 0x7F) != 0;
+    const auto [trackIndex, value] = msg;
+    const bool armed = value != 0;
     
     m_mixerModel->setTrackArmed(trackIndex, armed);
     
-    qDebug() << "Mixer Arm:" << trackIndex << "→" << armed;
+    PC_DEBUG(lcMixer) << "Mixer Arm:" << trackIndex << "→" << armed;
 }
 
-void SerialController::handleMixerSend(const QByteArray &payload)
+void SerialController::handleMixerSend(const Protocol::MixerSend::Message &msg)
 {
-    if (!m_mixerModel || payload.size() < 4)
+    if (!m_mixerModel)
         return;
 
-    const quint8 trackIndex = payload[0] & 0x7F;
-    const quint8 sendIndex = payload[1] & 0x7F;  // 0=SendA, 1=SendB, etc.
-    const quint8 valueMsb = payload[2] & 0x7F;
-    const quint8 valueLsb = payload[3] & 0x7F;
+    const auto [trackIndex, sendIndex, value14bit] = msg;  // sendIndex 0=SendA, 1=SendB, etc.
 
-    // Decode 14-bit value to 0.0-1.0
-    const int value14bit = decode14Bit(valueMsb, valueLsb);
-    const float sendLevel = qBound(0.0f, value14bit / 16383.0f, 1.0f);
+    m_mixerModel->setTrackSend14(trackIndex, sendIndex, value14bit);
 
-    m_mixerModel->setTrackSend(trackIndex, sendIndex, sendLevel);
-
-    qDebug() << "Mixer Send:" << trackIndex << "Send" << sendIndex << "→" << sendLevel;
+    PC_DEBUG(lcMixer) << "Mixer Send:" << trackIndex << "Send" << sendIndex << "→" << value14bit << "(14bit)";
 }
 
-void SerialController::handleMixerMode(const QByteArray &payload)
+void SerialController::handleMixerMode(const Protocol::MixerMode::Message &msg)
 {
-    if (payload.size() < 1)
-        return;
-
-    const quint8 mode = payload[0] & 0x7F;
+    const auto [mode] = msg;
 
     if (m_mixerMode != mode) {
         m_mixerMode = mode;
@@ -900,174 +1767,272 @@ void SerialController::handleMixerMode(const QByteArray &payload)
         // 0=VOLUME_PAN, 1=SENDS_AB, 2=SENDS_CD, 3=MASTER_RETURNS
         emit mixerModeChanged(mode);
 
-        qDebug() << "Mixer Mode changed to:" << mode;
+        PC_DEBUG(lcMixer) << "Mixer Mode changed to:" << mode;
     }
 }
 
-void SerialController::handleRingPosition(const QByteArray &payload)
+void SerialController::handleTrackMeters(const Protocol::TrackMeters::Message &msg)
 {
-    // Payload: [track_msb, track_lsb, scene_msb, scene_lsb, width, height, overview]
-    if (payload.size() < 7)
+    const auto &[firstTrack, levels] = msg;
+    if (levels.size() % 2 != 0) {
+        ++m_rxCommandRejected[CmdTrackMeters];
+        PC_WARN(lcMixer) << "Track meters: odd level count" << levels.size();
         return;
+    }
+
+    // Straight into the store: meters never touch MixerModel rows
+    m_meterStore->setLevels7(firstTrack, levels.data(), levels.size() / 2);
+}
 
-    const int trackOffset = ((payload[0] & 0x7F) << 7) | (payload[1] & 0x7F);
-    const int sceneOffset = ((payload[2] & 0x7F) << 7) | (payload[3] & 0x7F);
-    const int width = payload[4] & 0x7F;
-    const int height = payload[5] & 0x7F;
+void SerialController::handleRingPosition(const Protocol::RingPosition::Message &msg)
+{
+    const auto [trackOffset, sceneOffset, width, height, overview] = msg;
+    Q_UNUSED(overview)
 
     if (m_ringTrackOffset != trackOffset || m_ringSceneOffset != sceneOffset) {
-        qDebug() << "📍 Session ring moved:" << m_ringTrackOffset << "→" << trackOffset
-                 << "," << m_ringSceneOffset << "→" << sceneOffset;
+        PC_DEBUG(lcSession) << "📍 Session ring moved:" << m_ringTrackOffset << "→" << trackOffset
+                            << "," << m_ringSceneOffset << "→" << sceneOffset;
 
         m_ringTrackOffset = trackOffset;
         m_ringSceneOffset = sceneOffset;
 
-        // Clear models when ring position changes so new data can populate
-        if (m_trackModel) {
-            m_trackModel->resetAll();
-            qDebug() << "   ↳ TrackListModel cleared";
-        }
-        if (m_clipModel) {
-            m_clipModel->resetAll(QColor("#1a1a1a"));  // Reset to dark gray
-            qDebug() << "   ↳ ClipGridModel cleared";
-        }
+        // Repaint the new window from what we already know; the Teensy's
+        // re-send then only changes cells that were missing or stale
+        ++m_ringMoves;
+        const RingPrefetcher::MoveResult prefetched =
+            m_ringPrefetcher.ringMoved(trackOffset, sceneOffset, MonotonicClock::nowNs());
+        if (prefetched == RingPrefetcher::Hit)
+            PC_DEBUG(lcSession) << "   ↳ window was prefetched";
+        fillRingFromCache();
+        scheduleRingPrefetch();
 
         emit ringPositionChanged();
 
-        qDebug() << "📍 Session ring position:" << trackOffset << sceneOffset
-                 << QString("(%1x%2)").arg(width).arg(height);
+        PC_DEBUG(lcSession) << "📍 Session ring position:" << trackOffset << sceneOffset
+                            << QString("(%1x%2)").arg(width).arg(height);
     }
 }
 
-void SerialController::handleSessionRingMetadata(const QByteArray &payload)
+void SerialController::fillRingFromCache()
 {
-    // Bulk metadata: tracks and scenes with names and colors
-    // Format: [num_tracks] [track0: len, name..., R, G, B] ... [track7: ...]
-    //         [num_scenes] [scene0: len, name..., R, G, B] ... [scene3: ...]
-
-    int offset = 0;
-    if (payload.size() < 1) {
-        qWarning() << "Ring metadata bulk payload too short";
-        return;
+    const QRgb emptyClip = qRgb(0x1a, 0x1a, 0x1a);
+
+    if (m_clipModel) {
+        int hits = 0;
+        ClipGridModel::Batch batch(m_clipModel);
+        for (int scene = 0; scene < ClipGridModel::Scenes; ++scene) {
+            for (int track = 0; track < ClipGridModel::Tracks; ++track) {
+                const SessionCache::Clip *clip = m_sessionCache.clip(track + m_ringTrackOffset,
+                                                                     scene + m_ringSceneOffset);
+                const quint8 known = clip ? clip->known : 0;
+                hits += known ? 1 : 0;
+                m_clipModel->setClipName(track, scene, (known & SessionCache::HasName) ? clip->name : NamePool::Empty);
+                m_clipModel->setClipState(track, scene, (known & SessionCache::HasState) ? clip->state : 0);
+                m_clipModel->setClipColor(track, scene, (known & SessionCache::HasColor) ? clip->color : emptyClip);
+            }
+        }
+        m_ringCacheHits += quint64(hits);
+        m_ringCacheMisses += quint64(ClipGridModel::Cells - hits);
+        PC_DEBUG(lcSession) << "   ↳ ClipGridModel filled from cache:" << hits << "/" << ClipGridModel::Cells;
     }
 
-    // Parse tracks
-    quint8 numTracks = payload[offset++] & 0x7F;
-    qDebug() << "📦 Ring metadata bulk:" << numTracks << "tracks";
-
-    for (quint8 t = 0; t < numTracks && offset < payload.size(); t++) {
-        if (offset >= payload.size()) break;
-
-        quint8 nameLen = payload[offset++] & 0x7F;
-        if (offset + nameLen + 3 > payload.size()) break;  // name + RGB
-
-        QString trackName;
-        for (quint8 i = 0; i < nameLen; i++) {
-            trackName.append(QChar(payload[offset++] & 0x7F));
+    if (m_trackModel) {
+        for (int track = 0; track < m_trackModel->rowCount(); ++track) {
+            const SessionCache::Slot *slot = m_sessionCache.track(track + m_ringTrackOffset);
+            const NamePool::Handle name = (slot && (slot->known & SessionCache::HasName)) ? slot->name
+                                                                                           : NamePool::Empty;
+            m_trackModel->setTrackName(track, name);   // empty name resets the row
+            if (name != NamePool::Empty && (slot->known & SessionCache::HasColor))
+                m_trackModel->setTrackColor(track, QColor(slot->color));
         }
+    }
 
-        quint8 r7 = payload[offset++] & 0x7F;
-        quint8 g7 = payload[offset++] & 0x7F;
-        quint8 b7 = payload[offset++] & 0x7F;
+    if (m_sceneModel) {
+        for (int scene = 0; scene < m_sceneModel->rowCount(); ++scene) {
+            const int absoluteScene = scene + m_ringSceneOffset;
+            const SessionCache::Slot *slot = m_sessionCache.scene(absoluteScene);
+            const quint8 known = slot ? slot->known : 0;
+            if (known & SessionCache::HasName)
+                m_sceneModel->setSceneName(scene, slot->name);
+            else
+                m_sceneModel->setScenePlaceholder(scene, absoluteScene + 1);
+            m_sceneModel->setSceneColor(scene, (known & SessionCache::HasColor) ? QColor(slot->color) : QColor(emptyClip));
+        }
+    }
+}
 
-        // Convert 7-bit to 8-bit
-        quint8 r8 = r7 << 1;
-        quint8 g8 = g7 << 1;
-        quint8 b8 = b7 << 1;
+void SerialController::handleSessionRingMetadata(const PayloadView &payload)
+{
+    // Bulk metadata: tracks and scenes with names and colors
+    // Format: [num_tracks] [track0: len, name..., R, G, B] ... [track7: ...]
+    //         [num_scenes] [scene0: len, name..., R, G, B] ... [scene3: ...]
 
-        QColor trackColor(r8, g8, b8);
+    // Parse tracks
+    int numTracks = 0;
+    int offset = readNamedColors(payload, 0, &numTracks, [this](int t, NamePool::Handle trackName, const QColor &trackColor) {
+        m_sessionCache.setTrackName(t + m_ringTrackOffset, trackName);
+        m_sessionCache.setTrackColor(t + m_ringTrackOffset, trackColor.rgb());
 
         if (m_trackModel) {
             m_trackModel->setTrackName(t, trackName);
             m_trackModel->setTrackColor(t, trackColor);
         }
-    }
+    });
+    PC_DEBUG(lcSession) << "📦 Ring metadata bulk:" << numTracks << "tracks";
 
     // Clear tracks above the received count (handles track deletion)
+    for (int t = numTracks; numTracks > 0 && t < 8; ++t)
+        m_sessionCache.setTrackName(t + m_ringTrackOffset, NamePool::Empty);
     if (m_trackModel && numTracks > 0) {
         m_trackModel->clearAbove(numTracks - 1);
     }
 
     // Parse scenes
     if (offset < payload.size()) {
-        quint8 numScenes = payload[offset++] & 0x7F;
-        qDebug() << "📦 Ring metadata bulk:" << numScenes << "scenes";
-
-        for (quint8 s = 0; s < numScenes && offset < payload.size(); s++) {
-            if (offset >= payload.size()) break;
-
-            quint8 nameLen = payload[offset++] & 0x7F;
-            if (offset + nameLen + 3 > payload.size()) break;
-
-            QString sceneName;
-            for (quint8 i = 0; i < nameLen; i++) {
-                sceneName.append(QChar(payload[offset++] & 0x7F));
-            }
-
-            quint8 r7 = payload[offset++] & 0x7F;
-            quint8 g7 = payload[offset++] & 0x7F;
-            quint8 b7 = payload[offset++] & 0x7F;
-
-            // Convert 7-bit to 8-bit
-            quint8 r8 = r7 << 1;
-            quint8 g8 = g7 << 1;
-            quint8 b8 = b7 << 1;
-
-            QColor sceneColor(r8, g8, b8);
+        int numScenes = 0;
+        offset = readNamedColors(payload, offset, &numScenes, [this](int s, NamePool::Handle sceneName, const QColor &sceneColor) {
+            m_sessionCache.setSceneName(s + m_ringSceneOffset, sceneName);
+            m_sessionCache.setSceneColor(s + m_ringSceneOffset, sceneColor.rgb());
 
             if (m_sceneModel) {
                 m_sceneModel->setSceneName(s, sceneName);
                 m_sceneModel->setSceneColor(s, sceneColor);
             }
-        }
+        });
+        PC_DEBUG(lcSession) << "📦 Ring metadata bulk:" << numScenes << "scenes";
 
         // Clear scenes above the received count (handles scene deletion)
+        for (int s = numScenes; numScenes > 0 && s < 4; ++s)
+            m_sessionCache.forgetScene(s + m_ringSceneOffset);
         if (m_sceneModel && numScenes > 0) {
-            m_sceneModel->clearAbove(numScenes - 1);
+            m_sceneModel->clearAbove(numScenes - 1, m_ringSceneOffset);
         }
     }
 
-    qDebug() << "✅ Processed ring metadata bulk (" << payload.size() << "bytes)";
+    PC_DEBUG(lcSession) << "✅ Processed ring metadata bulk (" << payload.size() << "bytes)";
 }
 
-void SerialController::handleSessionRingClips(const QByteArray &payload)
+void SerialController::handleSessionRingClips(const PayloadView &payload)
 {
     // Bulk clips: 32 clips with states and colors
     // Format: [clip0: state, R, G, B] [clip1: ...] ... [clip31: ...]
     // Order: column-major (track 0 scenes 0-3, track 1 scenes 0-3, ...)
 
-    const int expectedBytes = 32 * 4;  // 32 clips × 4 bytes each
-    if (payload.size() < expectedBytes) {
-        qWarning() << "Ring clips bulk payload too short (got" << payload.size()
-                   << ", need" << expectedBytes << ")";
-        return;
+    // Length (32 clips × 4 bytes) already validated against the schema
+    PC_DEBUG(lcSession) << "📦 Ring clips bulk: 32 clips";
+
+    // Una sola notificación por tramo de filas cambiadas, no 64 por bulk
+    ClipGridModel::Batch batch(m_clipModel);
+    readRingClips(payload, [this](int track, int scene, int state, QRgb clipColor) {
+        m_sessionCache.setClipState(track + m_ringTrackOffset, scene + m_ringSceneOffset, state);
+        m_sessionCache.setClipColor(track + m_ringTrackOffset, scene + m_ringSceneOffset, clipColor);
+
+        if (m_clipModel) {
+            m_clipModel->setClipState(track, scene, state);
+            m_clipModel->setClipColor(track, scene, clipColor);
+        }
+    });
+
+    PC_DEBUG(lcSession) << "✅ Processed ring clips bulk (32 clips)";
+}
+
+// ═══════════════════════════════════════════════════════════
+// RING PREFETCH - neighbouring windows, straight into the cache
+// ═══════════════════════════════════════════════════════════
+
+void SerialController::handlePrefetchMetadata(const Protocol::PrefetchMetadata::Message &msg)
+{
+    const auto &[trackOffset, sceneOffset, body] = msg;
+
+    // Not on screen: only the cache learns about it until the ring gets there
+    int numTracks = 0;
+    int offset = readNamedColors(body, 0, &numTracks, [&](int t, NamePool::Handle name, const QColor &color) {
+        m_sessionCache.setTrackName(trackOffset + t, name);
+        m_sessionCache.setTrackColor(trackOffset + t, color.rgb());
+    });
+    for (int t = numTracks; numTracks > 0 && t < RingPrefetcher::WindowTracks; ++t)
+        m_sessionCache.setTrackName(trackOffset + t, NamePool::Empty);
+
+    if (offset < body.size()) {
+        int numScenes = 0;
+        readNamedColors(body, offset, &numScenes, [&](int s, NamePool::Handle name, const QColor &color) {
+            m_sessionCache.setSceneName(sceneOffset + s, name);
+            m_sessionCache.setSceneColor(sceneOffset + s, color.rgb());
+        });
+        for (int s = numScenes; numScenes > 0 && s < RingPrefetcher::WindowScenes; ++s)
+            m_sessionCache.forgetScene(sceneOffset + s);
     }
 
-    qDebug() << "📦 Ring clips bulk: 32 clips";
+    PC_DEBUG(lcSession) << "🔮 Prefetched metadata for window" << trackOffset << sceneOffset;
+    m_ringPrefetcher.received(trackOffset, sceneOffset, RingPrefetcher::Metadata, 4 + body.size());
+    scheduleRingPrefetch();
+}
 
-    int offset = 0;
-    for (int track = 0; track < 8; track++) {
-        for (int scene = 0; scene < 4; scene++) {
-            if (offset + 3 >= payload.size()) break;
+void SerialController::handlePrefetchClips(const Protocol::PrefetchClips::Message &msg)
+{
+    const auto &[trackOffset, sceneOffset, body] = msg;
 
-            quint8 state = payload[offset++] & 0x7F;
-            quint8 r7 = payload[offset++] & 0x7F;
-            quint8 g7 = payload[offset++] & 0x7F;
-            quint8 b7 = payload[offset++] & 0x7F;
+    readRingClips(body, [&](int track, int scene, int state, QRgb color) {
+        m_sessionCache.setClipState(trackOffset + track, sceneOffset + scene, state);
+        m_sessionCache.setClipColor(trackOffset + track, sceneOffset + scene, color);
+    });
 
-            // Convert 7-bit to 8-bit for RGB
-            quint8 r8 = r7 << 1;
-            quint8 g8 = g7 << 1;
-            quint8 b8 = b7 << 1;
+    PC_DEBUG(lcSession) << "🔮 Prefetched clips for window" << trackOffset << sceneOffset;
+    m_ringPrefetcher.received(trackOffset, sceneOffset, RingPrefetcher::Clips, 4 + body.size());
+    scheduleRingPrefetch();
+}
 
-            QColor clipColor(r8, g8, b8);
+void SerialController::reclaimNames()
+{
+    // Every handle holder marks, or a freed handle could come back under
+    // another name while still on screen
+    NamePool &pool = NamePool::instance();
+    pool.beginSweep();
+    m_sessionCache.markNames(pool);
+    if (m_clipModel)
+        m_clipModel->markNames(pool);
+    if (m_trackModel)
+        m_trackModel->markNames(pool);
+    if (m_sceneModel)
+        m_sceneModel->markNames(pool);
+    const int freed = pool.sweep();
+    PC_INFO(lcSession) << "♻️ Name pool: reclaimed" << freed << "names," << pool.size() << "in use";
+}
 
-            if (m_clipModel) {
-                m_clipModel->setClipState(track, scene, state);
-                m_clipModel->setClipColor(track, scene, clipColor);
-            }
-        }
+void SerialController::scheduleRingPrefetch()
+{
+    if (m_ringPrefetcher.hasWork() && !m_prefetchTimer.isActive())
+        m_prefetchTimer.start();
+}
+
+void SerialController::sendRingPrefetch()
+{
+    if (m_connectionState != Connected || !(m_linkFeatures & FeatureRingPrefetch)
+        || m_linkSwitchPending || m_replay.isActive())
+        return;
+
+    // Background traffic: wait until nothing else is going out and no
+    // foreground frame came in lately, so a prefetch never sits in front of
+    // a fader move or a ring re-send. Meters and pings don't count.
+    const qint64 now = MonotonicClock::nowNs();
+    const bool txBusy = !m_txQueue.isEmpty() || (!m_threadedIo && m_serial.bytesToWrite() > 0);
+    if (txBusy || now - m_lastForegroundRxNs < qint64(PrefetchIdleMs) * 1000 * 1000) {
+        m_prefetchTimer.start();
+        return;
+    }
+
+    int trackOffset = 0;
+    int sceneOffset = 0;
+    if (m_ringPrefetcher.nextRequest(now, &trackOffset, &sceneOffset)) {
+        PC_DEBUG(lcSession) << "🔮 Prefetch window" << trackOffset << sceneOffset;
+        const quint8 payload[4] = {
+            quint8((trackOffset >> 7) & 0x7F), quint8(trackOffset & 0x7F),
+            quint8((sceneOffset >> 7) & 0x7F), quint8(sceneOffset & 0x7F)
+        };
+        sendFrame(CmdRingPrefetch, payload, sizeof(payload));
     }
 
-    qDebug() << "✅ Processed ring clips bulk (32 clips)";
+    // Poll for the reply's timeout, or the next window once it lands
+    if (m_ringPrefetcher.hasWork())
+        m_prefetchTimer.start();
 }
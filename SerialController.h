@@ -6,11 +6,29 @@
 #include <QByteArray>
 #include <QTimer>
 #include <QBitArray>
+#include <QThread>
+#include <QVariantMap>
+
+#include <array>
+#include <atomic>
 
 #include "ClipGridModel.h"
 #include "TrackListModel.h"
 #include "SceneListModel.h"
 #include "MixerModel.h"
+#include "MeterStore.h"
+#include "ModelUpdateCoalescer.h"
+#include "SerialFrameParser.h"
+#include "ProtocolSchema.h"
+#include "SerialIoWorker.h"
+#include "SerialTxQueue.h"
+#include "MixerTxCoalescer.h"
+#include "SerialCapture.h"
+#include "SerialReplay.h"
+#include "LatencyHistogram.h"
+#include "UpdateLatencyTracer.h"
+#include "SessionCache.h"
+#include "RingPrefetcher.h"
 
 class SerialController : public QObject
 {
@@ -21,6 +39,7 @@ class SerialController : public QObject
     Q_PROPERTY(TrackListModel* trackModel READ trackModel CONSTANT)
     Q_PROPERTY(SceneListModel* sceneModel READ sceneModel CONSTANT)
     Q_PROPERTY(MixerModel* mixerModel READ mixerModel CONSTANT)
+    Q_PROPERTY(MeterStore* meterStore READ meterStore CONSTANT)
     Q_PROPERTY(bool transportPlaying READ transportPlaying NOTIFY transportStateChanged)
     Q_PROPERTY(bool transportRecording READ transportRecording NOTIFY transportRecordingChanged)
     Q_PROPERTY(bool transportLoop READ transportLoop NOTIFY transportStateChanged)
@@ -29,6 +48,17 @@ class SerialController : public QObject
     Q_PROPERTY(QString transportPosition READ transportPosition NOTIFY transportPositionChanged)
     Q_PROPERTY(QString portName READ portName WRITE setPortName NOTIFY portNameChanged)
     Q_PROPERTY(int baudRate READ baudRate WRITE setBaudRate NOTIFY baudRateChanged)
+    Q_PROPERTY(int maxBaudRate READ maxBaudRate WRITE setMaxBaudRate NOTIFY maxBaudRateChanged)
+    Q_PROPERTY(int linkBaudRate READ linkBaudRate NOTIFY linkBaudRateChanged)
+    Q_PROPERTY(bool threadedIo READ threadedIo WRITE setThreadedIo NOTIFY threadedIoChanged)
+    Q_PROPERTY(int mixerTxRateHz READ mixerTxRateHz WRITE setMixerTxRateHz NOTIFY mixerTxRateHzChanged)
+    Q_PROPERTY(int pingIntervalMs READ pingIntervalMs WRITE setPingIntervalMs NOTIFY pingIntervalMsChanged)
+    Q_PROPERTY(double pingRttP50Ms READ pingRttP50Ms NOTIFY pingStatsChanged)
+    Q_PROPERTY(double pingRttP99Ms READ pingRttP99Ms NOTIFY pingStatsChanged)
+    Q_PROPERTY(double pingRttMaxMs READ pingRttMaxMs NOTIFY pingStatsChanged)
+    Q_PROPERTY(int pingsLost READ pingsLost NOTIFY pingStatsChanged)
+    Q_PROPERTY(bool captureActive READ captureActive NOTIFY captureActiveChanged)
+    Q_PROPERTY(bool replayActive READ replayActive NOTIFY replayActiveChanged)
     Q_PROPERTY(int mixerMode READ mixerMode NOTIFY mixerModeChanged)
     Q_PROPERTY(int ringTrackOffset READ ringTrackOffset NOTIFY ringPositionChanged)
     Q_PROPERTY(int ringSceneOffset READ ringSceneOffset NOTIFY ringPositionChanged)
@@ -42,6 +72,7 @@ public:
     Q_ENUM(ConnectionState)
 
     explicit SerialController(QObject *parent = nullptr);
+    ~SerialController() override;
 
     bool isConnected() const { return m_connected; }
     ConnectionState connectionState() const { return m_connectionState; }
@@ -51,6 +82,54 @@ public:
     int baudRate() const { return m_baudRate; }
     void setBaudRate(int baud);
 
+    // Highest rate offered to the firmware in the handshake (0 = never switch)
+    int maxBaudRate() const { return m_maxBaudRate; }
+    void setMaxBaudRate(int baud);
+    // Rate the link actually runs at: baudRate until a switch is confirmed
+    int linkBaudRate() const { return m_linkBaudRate; }
+
+    // Port, framing and checksum on a dedicated thread (PUSHCLONE_SERIAL_THREAD=1)
+    bool threadedIo() const { return m_threadedIo; }
+    void setThreadedIo(bool enabled);
+
+    // Outgoing fader moves are coalesced and sent at most this often per slot
+    int mixerTxRateHz() const { return m_mixerTxRateHz; }
+    void setMixerTxRateHz(int hz);
+
+    // Timestamped CMD_PING while connected (0 = off, PUSHCLONE_PING_MS)
+    int pingIntervalMs() const { return m_pingIntervalMs; }
+    void setPingIntervalMs(int ms);
+    // Round-trip time of the GUI's pings, from the latency histogram
+    double pingRttP50Ms() const { return m_pingRtt.percentile(50.0) / 1000.0; }
+    double pingRttP99Ms() const { return m_pingRtt.percentile(99.0) / 1000.0; }
+    double pingRttMaxMs() const { return m_pingRtt.max() / 1000.0; }
+    int pingsLost() const { return int(m_pingsLost); }
+    // Full RTT distribution in HdrHistogram .hgrm format (milliseconds)
+    Q_INVOKABLE bool dumpPingHistogram(const QString &path) const;
+    // Per-command readyRead → model → frameSwapped latencies (see UpdateLatencyTracer)
+    Q_INVOKABLE bool dumpUpdateLatency(const QString &path) const;
+    // Hooked to QQuickWindow::afterAnimating / frameSwapped in main.cpp
+    void notifyAfterAnimating();
+    void notifyFrameSwapped();
+
+    // Runtime counters (queue depth, hand-off latency, ...) for diagnostics
+    Q_INVOKABLE QVariantMap statistics() const;
+    Q_INVOKABLE void resetStatistics();
+    // Binary frame trace (see TraceRing); decode with tools/trace_decode
+    Q_INVOKABLE bool dumpTrace(const QString &path) const;
+
+    // Raw RX capture (SerialCapture format) and replay in place of the port
+    Q_INVOKABLE bool startCapture(const QString &path);
+    Q_INVOKABLE void stopCapture();
+    bool captureActive() const;
+    Q_INVOKABLE bool startReplay(const QString &path, bool realtime = true);
+    Q_INVOKABLE void stopReplay();
+    bool replayActive() const { return m_replay.isActive(); }
+    Q_INVOKABLE bool dumpFlightRecorder(const QString &path) const;
+
+    // Feeds raw bytes through framing and dispatch as if read from the port
+    void injectRxBytes(const char *data, int size);
+
     Q_INVOKABLE void reconnect();
     Q_INVOKABLE void requestDisconnect();
     Q_INVOKABLE void sendTransportPlay(bool state);
@@ -64,6 +143,8 @@ public:
     TrackListModel* trackModel() const { return m_trackModel; }
     SceneListModel* sceneModel() const { return m_sceneModel; }
     MixerModel* mixerModel() const { return m_mixerModel; }
+    MeterStore* meterStore() const { return m_meterStore; }
+    ModelUpdateCoalescer* modelCoalescer() const { return m_modelCoalescer; }
 
     bool transportPlaying() const { return m_transportPlaying; }
     bool transportRecording() const { return m_transportRecording; }
@@ -80,6 +161,14 @@ signals:
     void connectionStateChanged();
     void portNameChanged();
     void baudRateChanged();
+    void maxBaudRateChanged();
+    void linkBaudRateChanged();
+    void threadedIoChanged();
+    void mixerTxRateHzChanged();
+    void pingIntervalMsChanged();
+    void pingStatsChanged();
+    void captureActiveChanged();
+    void replayActiveChanged();
     void connectionError(const QString &message);
     void transportStateChanged();
     void transportRecordingChanged();
@@ -94,54 +183,188 @@ private slots:
     void handleError(QSerialPort::SerialPortError error);
     void handleReconnectTimeout();
     void handleTrackBatchTimeout();
+    void drainRxQueue();
+    void handleIoOpened();
+    void handleIoOpenFailed(const QString &message);
+    void handleIoError(const QString &message);
+    void flushTxQueue();
+    void handleLinkCheckTimeout();
+    void handleLinkLost();
+    void flushMixerTx();
+    void sendPing();
+    void sendRingPrefetch();
 
 private:
     void openPort();
     void closePort();
-    void processFrame(quint8 cmd, const QByteArray &payload);
+    bool isPortOpen() const;
+    void startIoThread();
+    void stopIoThread();
+    int parseRxBuffer();
+    void processFrame(quint8 cmd, const PayloadView &payload);
     void sendFrame(quint8 cmd, const QByteArray &payload = QByteArray());
-    quint8 calculateChecksum(quint8 cmd, quint8 len, const QByteArray &payload) const;
+    void sendFrame(quint8 cmd, const quint8 *payload, int len);
+    void scheduleTxFlush();
+    void queueMixerParameter(int track, int parameter, float value);
+    void setFramingVersion(SerialFrameParser::FramingVersion version);
+    void applyLinkBaudRate(int baud);
+    void resetLinkCaps();
     void setConnected(bool value);
     void setConnectionState(ConnectionState state);
-    void handleClipName(const QByteArray &payload);
-    void handleGridUpdate7bit(const QByteArray &payload);
-    void handleGridUpdate14bit(const QByteArray &payload);
-    void handlePadUpdate14bit(const QByteArray &payload);
-    void handlePadUpdate7bit(const QByteArray &payload);
-    void handleClipState(const QByteArray &payload);
+    // Typed handlers: Protocol::<Command>::Message is decoded from the schema
+    void handleHandshake(const PayloadView &payload);
+    void handlePing(const PayloadView &payload);
+    void handleLinkCheck(const PayloadView &payload);
+    void handleDisconnect(const PayloadView &payload);
+    void handleSelectedTrack(const Protocol::SelectedTrack::Message &msg);
+    void handleShiftState(const Protocol::ShiftState::Message &msg);
+    void handleClipName(const Protocol::ClipName::Message &msg);
+    void handleGridUpdate7bit(const PayloadView &payload);
+    void handleGridUpdate14bit(const PayloadView &payload);
+    void handlePadUpdate14bit(const PayloadView &payload);
+    void handleGridDelta14bit(const Protocol::GridDelta14::Message &msg);
+    void handlePadUpdate7bit(const Protocol::PadUpdate7::Message &msg);
+    void handleClipState(const Protocol::ClipState::Message &msg);
     void updatePadColor(int track, int scene, const QColor &color);
-    void handleTrackName(const QByteArray &payload);
-    void handleTrackColor(const QByteArray &payload);
-    void handleSceneName(const QByteArray &payload);
-    void handleSceneColor(const QByteArray &payload);
-    void handleSceneTriggered(const QByteArray &payload);
-    void handleTransportCommand(quint8 cmd, const QByteArray &payload);
+    void applyGridColors(int padCount, const QRgb *colors);
+    void fillRingFromCache();
+    void handleTrackName(const Protocol::TrackName::Message &msg);
+    void handleTrackColor(const PayloadView &payload);
+    void handleSceneName(const Protocol::SceneName::Message &msg);
+    void handleSceneColor(const PayloadView &payload);
+    void handleSceneTriggered(const Protocol::SceneTriggered::Message &msg);
+    void handleTransportCommand(quint8 cmd, const PayloadView &payload);
     void scheduleTrackCleanup(int trackIndex);
     
     // Mixer handlers
-    void handleMixerVolume(const QByteArray &payload);
-    void handleMixerPan(const QByteArray &payload);
-    void handleMixerMute(const QByteArray &payload);
-    void handleMixerSolo(const QByteArray &payload);
-    void handleMixerArm(const QByteArray &payload);
-    void handleMixerSend(const QByteArray &payload);
-    void handleMixerMode(const QByteArray &payload);
-    void handleRingPosition(const QByteArray &payload);
-    void handleSessionRingMetadata(const QByteArray &payload);
-    void handleSessionRingClips(const QByteArray &payload);
+    void handleMixerVolume(const Protocol::MixerVolume::Message &msg);
+    void handleMixerPan(const Protocol::MixerPan::Message &msg);
+    void handleMixerMute(const Protocol::MixerMute::Message &msg);
+    void handleMixerSolo(const Protocol::MixerSolo::Message &msg);
+    void handleMixerArm(const Protocol::MixerArm::Message &msg);
+    void handleMixerSend(const Protocol::MixerSend::Message &msg);
+    void handleMixerMode(const Protocol::MixerMode::Message &msg);
+    void handleTrackMeters(const Protocol::TrackMeters::Message &msg);
+    void handleRingPosition(const Protocol::RingPosition::Message &msg);
+    void handleSessionRingMetadata(const PayloadView &payload);
+    void handleSessionRingClips(const PayloadView &payload);
+    void handlePrefetchMetadata(const Protocol::PrefetchMetadata::Message &msg);
+    void handlePrefetchClips(const Protocol::PrefetchClips::Message &msg);
+    void scheduleRingPrefetch();
+    void reclaimNames();
+
+    // Dispatch: one entry per command ID, built from the schema at compile time
+    struct DispatchEntry {
+        void (SerialController::*handler)(quint8 cmd, const PayloadView &payload) = nullptr;
+        quint16 minLen = 0;
+        quint16 maxLen = 0;
+    };
+    using DispatchTable = std::array<DispatchEntry, 256>;
+    static const DispatchTable &dispatchTable();
+    template <typename Spec, void (SerialController::*Handler)(const typename Spec::Message &)>
+    void dispatchTyped(quint8 cmd, const PayloadView &payload);
+    template <void (SerialController::*Handler)(const PayloadView &)>
+    void dispatchRaw(quint8 cmd, const PayloadView &payload);
 
     QSerialPort m_serial;
-    QByteArray m_rxBuffer;
+    SerialFrameParser m_rxParser;
+    SerialReplay m_replay;
+
+    // Threaded I/O mode
+    bool m_threadedIo = false;
+    QThread *m_ioThread = nullptr;
+    SerialIoWorker *m_ioWorker = nullptr;
+    SerialRxQueue m_rxQueue;
+    std::atomic_bool m_rxDrainPending { false };
+    quint64 m_ioGeneration = 0;
+    bool m_ioPortOpen = false;
+    bool m_ioOpenPending = false;
+
+    // Hand-off counters (GUI thread only)
+    quint64 m_rxEventsDelivered = 0;
+    quint64 m_rxDrains = 0;
+    int m_rxQueueDepthMax = 0;
+    qint64 m_handoffLatencyTotalNs = 0;
+    qint64 m_handoffLatencyMaxNs = 0;
+
+    // Update latency tracing; m_rxTimestampNs is the readyRead of the
+    // frame being dispatched (0 = unknown, not traced)
+    UpdateLatencyTracer m_latencyTracer;
+    qint64 m_rxTimestampNs = 0;
+
+    // Per-command counters, indexed by command ID
+    std::array<quint32, 256> m_rxCommandCounts {};
+    std::array<quint32, 256> m_rxCommandRejected {};
+    quint64 m_rxUnknownCommands = 0;
+
+    // Grid delta savings vs. a full CMD_GRID_UPDATE_14 payload
+    quint64 m_gridDeltaFrames = 0;
+    quint64 m_gridDeltaPads = 0;
+    quint64 m_gridDeltaBytesSaved = 0;
+
+    // Everything received, by absolute index; repaints the ring on a move
+    SessionCache m_sessionCache;
+    quint64 m_ringMoves = 0;
+    quint64 m_ringCacheHits = 0;     // visible clip cells filled from cache
+    quint64 m_ringCacheMisses = 0;   // visible clip cells left blank
+
+    // Neighbouring ring windows fetched ahead of the user, link idle only
+    static constexpr int PrefetchIdleMs = 20;
+    RingPrefetcher m_ringPrefetcher;
+    QTimer m_prefetchTimer;
+    qint64 m_lastForegroundRxNs = 0;   // last RX frame other than meters/pings/prefetch
+
+    // Outgoing frames, written once per event-loop turn
+    SerialTxQueue m_txQueue;
+    bool m_txFlushScheduled = false;
+
+    // Outgoing mixer moves (touch faders), last value wins per slot
+    MixerTxCoalescer m_mixerTx;
+    QTimer m_mixerTxTimer;
+    int m_mixerTxRateHz = 100;
+    quint64 m_txBatches = 0;
+    quint64 m_txWrites = 0;
+    qint64 m_txWriteStallTotalNs = 0;
+    qint64 m_txWriteStallMaxNs = 0;
+
     bool m_connected = false;
     ConnectionState m_connectionState = Disconnected;
     QString m_portName = QStringLiteral("/dev/serial0");
     int m_baudRate = 115200;
+    int m_maxBaudRate = 1000000;
+
+    // Negotiated link (handshake capabilities)
+    int m_linkBaudRate = 115200;
+    bool m_linkSwitchPending = false;      // TX held until CMD_LINK_CHECK
+    bool m_baudSwitchDisabled = false;     // a switch failed on this port
+    QTimer m_linkCheckTimer;
+    quint16 m_linkFeatures = 0;
+    int m_peerMaxPayload = SerialFrameParser::MaxPayloadV1;
+    quint64 m_baudSwitches = 0;
+    quint64 m_baudFallbacks = 0;
+
+    // Link latency: GUI pings carry a 14-bit sequence the peer echoes back
+    struct PendingPing {
+        quint16 seq = 0;
+        qint64 sentNs = 0;      // MonotonicClock; 0 = slot free
+    };
+    static constexpr int PingSlots = 64;
+    std::array<PendingPing, PingSlots> m_pendingPings {};
+    QTimer m_pingTimer;
+    int m_pingIntervalMs = 1000;
+    quint16 m_pingSeq = 0;
+    LatencyHistogram m_pingRtt;      // microseconds
+    quint64 m_pingsSent = 0;
+    quint64 m_pingsLost = 0;
+    quint64 m_pingsUnmatched = 0;
     QTimer m_reconnectTimer;
     QTimer m_trackCleanupTimer;
     ClipGridModel *m_clipModel = nullptr;
     TrackListModel *m_trackModel = nullptr;
     SceneListModel *m_sceneModel = nullptr;
     MixerModel *m_mixerModel = nullptr;
+    MeterStore *m_meterStore = nullptr;
+    ModelUpdateCoalescer *m_modelCoalescer = nullptr;
     bool m_transportPlaying = false;
     bool m_transportRecording = false;
     bool m_transportLoop = false;
@@ -153,47 +376,6 @@ private:
     int m_ringSceneOffset = 0;
     QBitArray m_trackPresence;
     bool m_trackBatchSawZero = false;
-
-    enum Cmd {
-        CmdHandshake = 0x00,
-        CmdHandshakeReply = 0x01,
-        CmdDisconnect = 0x02,
-        CmdPing = 0x03,
-        CmdSelectedTrack = 0x06,
-        CmdGridUpdate7bit = 0x60,
-        CmdGridUpdate14bit = 0xA6, // CmdLedGridUpdate14
-        CmdPadUpdate7bit = 0x84,   // CmdLedRgbState
-        CmdPadUpdate14bit = 0xA7,  // CmdLedPadUpdate14
-        CmdClipTrigger = 0x11,
-        CmdClipName = 0x14,
-        CmdClipState = 0x10,
-        CmdTrackName = 0x27,
-        CmdTrackColor = 0x28,
-        CmdSceneName = 0x1B,
-        CmdSceneColor = 0x1C,
-        CmdSceneState = 0x1A,
-        CmdSceneTriggered = 0x1D,
-        CmdTransportPlay = 0x40,
-        CmdTransportRecord = 0x41,
-        CmdTransportLoop = 0x42,
-        CmdTransportTempo = 0x43,
-        CmdTransportPosition = 0x45,
-        CmdTransportState = 0x49,
-        CmdShiftState = 0x88,
-        CmdRingPosition = 0x0C,  // Session ring position update
-        // Mixer commands
-        CmdMixerVolume = 0x21,
-        CmdMixerPan = 0x22,
-        CmdMixerMute = 0x23,
-        CmdMixerSolo = 0x24,
-        CmdMixerArm = 0x25,
-        CmdMixerSend = 0x26,
-        CmdTrackSelect = 0x0D,     // GUI → Teensy → Live: select track
-        CmdMixerMode = 0x98,
-        CmdMixerBankChange = 0x99,  // GUI → Teensy: notify bank change for fader pickup
-        CmdSessionRingMetadata = 0x9A,  // Bulk session ring metadata (tracks/scenes names+colors)
-        CmdSessionRingClips = 0x9B      // Bulk session ring clips (32 clips states+colors)
-    };
 };
 
 #endif // SERIALCONTROLLER_H
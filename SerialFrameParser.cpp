@@ -0,0 +1,241 @@
+#include "SerialFrameParser.h"
+
+#include <QIODevice>
+
+SerialFrameParser::SerialFrameParser()
+{
+    m_storage.fill(0);
+    m_scratch.fill(0);
+}
+
+void SerialFrameParser::clear()
+{
+    m_readIndex = 0;
+    m_writeIndex = 0;
+    m_delimiterScan = 0;
+    m_consecutiveErrors = 0;
+}
+
+void SerialFrameParser::setFramingVersion(FramingVersion version)
+{
+    if (m_version == version)
+        return;
+    // Bytes already buffered were sent in the new framing (the switch is
+    // always acknowledged before the peer changes), so keep them.
+    m_version = version;
+    m_delimiterScan = 0;
+    m_consecutiveErrors = 0;
+}
+
+qint64 SerialFrameParser::readFrom(QIODevice &device)
+{
+    qint64 total = 0;
+
+    // At most two contiguous regions: up to the end of storage, then from 0
+    while (freeSpace() > 0) {
+        const quint32 writePos = m_writeIndex & Mask;
+        const qint64 contiguous = qMin<qint64>(freeSpace(), Capacity - writePos);
+        const qint64 n = device.read(reinterpret_cast<char *>(m_storage.data() + writePos), contiguous);
+        if (n <= 0)
+            break;
+        m_writeIndex += quint32(n);
+        total += n;
+        if (n < contiguous)
+            break; // device drained
+    }
+
+    return total;
+}
+
+int SerialFrameParser::append(const char *data, int size)
+{
+    const int count = qMin(size, freeSpace());
+    int copied = 0;
+    while (copied < count) {
+        const quint32 writePos = m_writeIndex & Mask;
+        const int chunk = qMin(count - copied, int(Capacity - writePos));
+        std::memcpy(m_storage.data() + writePos, data + copied, size_t(chunk));
+        m_writeIndex += quint32(chunk);
+        copied += chunk;
+    }
+    return copied;
+}
+
+bool SerialFrameParser::syncToHeader()
+{
+    const int available = size();
+    int skip = 0;
+    while (skip < available && byteAt(skip) != FrameHeader)
+        ++skip;
+
+    if (skip > 0) {
+        // Quitar bytes previos hasta el siguiente SYNC
+        if (skip == available) {
+            PC_WARN(lcSerialRx) << "Descartando" << skip << "bytes sin SYNC";
+        }
+        consume(skip);
+        m_bytesDiscarded += quint64(skip);
+    }
+
+    return size() > 0;
+}
+
+PayloadView SerialFrameParser::viewAt(int offset, int len)
+{
+    const quint32 start = (m_readIndex + quint32(offset)) & Mask;
+    if (start + quint32(len) <= quint32(Capacity))
+        return PayloadView(m_storage.data() + start, len);
+
+    // Payload wraps around the end of storage: linearise into scratch
+    const int head = int(Capacity - start);
+    std::memcpy(m_scratch.data(), m_storage.data() + start, size_t(head));
+    std::memcpy(m_scratch.data() + head, m_storage.data(), size_t(len - head));
+    return PayloadView(m_scratch.data(), len);
+}
+
+bool SerialFrameParser::nextFrame(quint8 &cmd, PayloadView &payload)
+{
+    return m_version == FramingV2 ? nextFrameV2(cmd, payload) : nextFrameV1(cmd, payload);
+}
+
+bool SerialFrameParser::nextFrameV1(quint8 &cmd, PayloadView &payload)
+{
+    while (syncToHeader()) {
+        if (size() < HeaderSize)
+            return false;
+
+        cmd = byteAt(1);
+        const int len = byteAt(2);
+        const int totalSize = HeaderSize + len + 1;
+        if (size() < totalSize)
+            return false; // wait for more data
+
+        quint8 sum = cmd ^ quint8(len);
+        for (int i = 0; i < len; ++i)
+            sum ^= byteAt(HeaderSize + i);
+
+        if (sum != byteAt(HeaderSize + len)) {
+            TraceRing::instance().record(TraceRing::RxChecksumError, cmd, nullptr, len);
+            PC_WARN(lcSerialRx) << "Checksum mismatch for cmd" << Qt::hex << cmd << "len" << Qt::dec << len;
+            ++m_checksumErrors;
+            // Reiniciar parser desde el próximo SYNC
+            consume(1);
+            ++m_bytesDiscarded;
+            continue;
+        }
+
+        payload = viewAt(HeaderSize, len);
+        consume(totalSize);
+        ++m_framesParsed;
+        return true;
+    }
+    return false;
+}
+
+bool SerialFrameParser::nextFrameV2(quint8 &cmd, PayloadView &payload)
+{
+    while (m_version == FramingV2) {
+        // Find the delimiter, resuming where the previous pass stopped
+        const int available = size();
+        int end = m_delimiterScan;
+        while (end < available && byteAt(end) != FrameDelimiterV2)
+            ++end;
+
+        if (end == available) {
+            m_delimiterScan = end;
+            if (available > MaxEncodedV2) {
+                // No delimiter within the largest legal frame: drop it all
+                PC_WARN(lcSerialRx) << "Descartando" << available << "bytes sin delimitador";
+                consume(available);
+                m_bytesDiscarded += quint64(available);
+                m_delimiterScan = 0;
+            }
+            return false;
+        }
+        m_delimiterScan = 0;
+
+        if (end == 0) {
+            consume(1); // empty packet (idle filler / explicit resync)
+            continue;
+        }
+
+        // COBS decode into scratch
+        int out = 0;
+        int in = 0;
+        bool malformed = end > MaxEncodedV2;
+        while (!malformed && in < end) {
+            const int code = byteAt(in++);
+            for (int k = 1; k < code; ++k) {
+                if (in >= end || out >= ScratchSize) {
+                    malformed = true;
+                    break;
+                }
+                m_scratch[out++] = byteAt(in++);
+            }
+            if (!malformed && code != 0xFF && in < end) {
+                if (out >= ScratchSize)
+                    malformed = true;
+                else
+                    m_scratch[out++] = 0;
+            }
+        }
+
+        if (malformed || out < HeaderSizeV2 + CrcSize) {
+            rejectFrameV2(end + 1, out > 0 ? m_scratch[0] : 0, -1);
+            continue;
+        }
+
+        cmd = m_scratch[0];
+        const int len = (m_scratch[1] << 8) | m_scratch[2];
+        const int crcAt = HeaderSizeV2 + len;
+        if (out != crcAt + CrcSize
+            || crc16(m_scratch.data(), crcAt) != quint16((m_scratch[crcAt] << 8) | m_scratch[crcAt + 1])) {
+            rejectFrameV2(end + 1, cmd, len);
+            continue;
+        }
+
+        payload = PayloadView(m_scratch.data() + HeaderSizeV2, len);
+        consume(end + 1);
+        m_consecutiveErrors = 0;
+        ++m_framesParsed;
+        return true;
+    }
+
+    // Fell back to v1 while scanning
+    return nextFrameV1(cmd, payload);
+}
+
+void SerialFrameParser::rejectFrameV2(int encodedSize, quint8 cmd, int len)
+{
+    TraceRing::instance().record(TraceRing::RxChecksumError, cmd, nullptr, qMax(0, len));
+    PC_WARN(lcSerialRx) << "Bad v2 frame for cmd" << Qt::hex << cmd << "len" << Qt::dec << len;
+    ++m_checksumErrors;
+    consume(encodedSize);
+    m_bytesDiscarded += quint64(encodedSize);
+
+    // A run of garbage means the peer went back to v1 (reset, old firmware
+    // flashed in place): parse v1 again so its handshake gets through.
+    if (++m_consecutiveErrors >= FallbackErrorThreshold) {
+        PC_WARN(lcSerialRx) << "Demasiados errores en framing v2, volviendo a v1";
+        ++m_framingFallbacks;
+        setFramingVersion(FramingV1);
+    }
+}
+
+quint16 SerialFrameParser::crc16(const quint8 *data, int len, quint16 crc)
+{
+    static constexpr auto table = []() {
+        std::array<quint16, 256> t {};
+        for (int i = 0; i < 256; ++i) {
+            quint16 value = quint16(i << 8);
+            for (int bit = 0; bit < 8; ++bit)
+                value = quint16((value & 0x8000) ? (value << 1) ^ 0x1021 : value << 1);
+            t[i] = value;
+        }
+        return t;
+    }();
+
+    for (int i = 0; i < len; ++i)
+        crc = quint16((crc << 8) ^ table[((crc >> 8) ^ data[i]) & 0xFF]);
+    return crc;
+}
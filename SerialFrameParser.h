@@ -0,0 +1,196 @@
+#ifndef SERIALFRAMEPARSER_H
+#define SERIALFRAMEPARSER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QDebug>
+
+#include <array>
+#include <cstring>
+
+#include "PushCloneLogging.h"
+#include "TraceRing.h"
+
+class QIODevice;
+
+// ═══════════════════════════════════════════════════════════
+// PAYLOAD VIEW - Non-owning window over a frame payload
+// ═══════════════════════════════════════════════════════════
+// Only valid for the duration of the handler call: the bytes live in the
+// parser ring (or in its wrap scratch buffer) and are reused afterwards.
+class PayloadView
+{
+public:
+    PayloadView() = default;
+    PayloadView(const quint8 *data, int size) : m_data(data), m_size(size) {}
+
+    const quint8 *data() const { return m_data; }
+    const char *constData() const { return reinterpret_cast<const char *>(m_data); }
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    quint8 at(int i) const { return m_data[i]; }
+    quint8 operator[](int i) const { return m_data[i]; }
+    const quint8 *begin() const { return m_data; }
+    const quint8 *end() const { return m_data + m_size; }
+
+    // Deep copy, for the rare paths that need to keep the bytes
+    QByteArray toByteArray() const { return QByteArray(constData(), m_size); }
+
+    bool operator==(const QByteArray &other) const
+    {
+        return other.size() == m_size
+            && (m_size == 0 || std::memcmp(m_data, other.constData(), m_size) == 0);
+    }
+    bool operator!=(const QByteArray &other) const { return !(*this == other); }
+
+private:
+    const quint8 *m_data = nullptr;
+    int m_size = 0;
+};
+
+// ═══════════════════════════════════════════════════════════
+// SERIAL FRAME PARSER - Fixed-capacity ring, zero-copy frames
+// ═══════════════════════════════════════════════════════════
+// Framing v1 (default, every firmware):
+//   [0xAA] [cmd] [len] [payload × len] [checksum]
+//   checksum = cmd ^ len ^ payload[0] ^ ... ^ payload[len-1]
+//
+// Framing v2 (negotiated in the handshake, see SerialController):
+//   COBS([cmd] [len_hi] [len_lo] [payload × len] [crc_hi] [crc_lo]) [0x00]
+//   crc = CRC-16/CCITT-FALSE over cmd, len and payload
+//   0x00 never appears inside an encoded frame, so resync is simply "next
+//   delimiter", payload bytes are full 8-bit and len goes up to MaxPayload.
+//
+// Bytes are read straight from the device into preallocated storage and
+// consumed by advancing the read index, so a burst of N frames costs O(N)
+// instead of the O(N²) memmove of QByteArray::remove(0, n).
+class SerialFrameParser
+{
+public:
+    enum FramingVersion {
+        FramingV1 = 1,
+        FramingV2 = 2
+    };
+
+    static constexpr quint8 FrameHeader = 0xAA;
+    static constexpr int HeaderSize = 3;     // sync + cmd + len
+    static constexpr int MaxPayloadV1 = 255;
+    static constexpr int MaxFrameSize = HeaderSize + MaxPayloadV1 + 1;
+
+    static constexpr quint8 FrameDelimiterV2 = 0x00;
+    static constexpr int HeaderSizeV2 = 3;   // cmd + len_hi + len_lo (before COBS)
+    static constexpr int CrcSize = 2;
+    static constexpr int MaxPayload = 1024;  // largest payload in any framing
+    static constexpr int MaxPacketV2 = HeaderSizeV2 + MaxPayload + CrcSize;
+    // COBS adds one code byte per 254 data bytes (+1), plus the delimiter
+    static constexpr int MaxEncodedV2 = MaxPacketV2 + MaxPacketV2 / 254 + 2;
+    // Consecutive bad v2 frames before falling back to v1 (firmware reset)
+    static constexpr int FallbackErrorThreshold = 8;
+
+    static constexpr int Capacity = 4096;    // must be a power of two
+
+    SerialFrameParser();
+
+    void clear();
+    int size() const { return int(m_writeIndex - m_readIndex); }
+    int freeSpace() const { return Capacity - size(); }
+
+    FramingVersion framingVersion() const { return m_version; }
+    void setFramingVersion(FramingVersion version);
+
+    // Reads as much as fits from the device directly into the ring.
+    qint64 readFrom(QIODevice &device);
+    // Copies bytes into the ring (replay, benchmarks). Returns bytes taken.
+    int append(const char *data, int size);
+    // Calls visitor(const quint8 *, int) for the last count bytes written,
+    // in order (two spans when they wrap). Used to tap RX for capture.
+    template <typename Visitor>
+    void visitLastWritten(int count, Visitor &&visitor) const;
+
+    // Extracts every complete frame and calls handler(cmd, payloadView).
+    // The handler may switch the framing version; the next frame uses it.
+    // Returns the number of frames delivered.
+    template <typename Handler>
+    int parse(Handler &&handler);
+
+    quint64 framesParsed() const { return m_framesParsed; }
+    quint64 checksumErrors() const { return m_checksumErrors; }
+    quint64 bytesDiscarded() const { return m_bytesDiscarded; }
+    quint64 framingFallbacks() const { return m_framingFallbacks; }
+
+    static quint8 checksum(quint8 cmd, const quint8 *payload, int len)
+    {
+        quint8 sum = cmd ^ quint8(len);
+        for (int i = 0; i < len; ++i)
+            sum ^= payload[i];
+        return sum;
+    }
+
+    // CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), chainable through crc
+    static quint16 crc16(const quint8 *data, int len, quint16 crc = 0xFFFF);
+
+private:
+    static constexpr quint32 Mask = Capacity - 1;
+    static constexpr int ScratchSize = MaxPacketV2;
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Capacity >= 2 * MaxFrameSize, "Ring must hold at least two frames");
+    static_assert(Capacity >= 2 * MaxEncodedV2, "Ring must hold at least two v2 frames");
+
+    quint8 byteAt(int offset) const { return m_storage[(m_readIndex + quint32(offset)) & Mask]; }
+    void consume(int count) { m_readIndex += quint32(count); }
+    bool syncToHeader();
+    PayloadView viewAt(int offset, int len);
+
+    // Next valid frame, skipping garbage; false when more bytes are needed
+    bool nextFrame(quint8 &cmd, PayloadView &payload);
+    bool nextFrameV1(quint8 &cmd, PayloadView &payload);
+    bool nextFrameV2(quint8 &cmd, PayloadView &payload);
+    void rejectFrameV2(int encodedSize, quint8 cmd, int len);
+
+    std::array<quint8, Capacity> m_storage;
+    std::array<quint8, ScratchSize> m_scratch;  // wrapped v1 payloads, decoded v2 packets
+    quint32 m_readIndex = 0;                    // free-running, masked on access
+    quint32 m_writeIndex = 0;
+    int m_delimiterScan = 0;                    // v2: bytes already known to hold no delimiter
+    FramingVersion m_version = FramingV1;
+    int m_consecutiveErrors = 0;
+
+    quint64 m_framesParsed = 0;
+    quint64 m_checksumErrors = 0;
+    quint64 m_bytesDiscarded = 0;
+    quint64 m_framingFallbacks = 0;
+};
+
+template <typename Visitor>
+void SerialFrameParser::visitLastWritten(int count, Visitor &&visitor) const
+{
+    count = qMin(count, size());
+    if (count <= 0)
+        return;
+    const quint32 start = (m_writeIndex - quint32(count)) & Mask;
+    const int head = qMin(count, int(Capacity - start));
+    visitor(m_storage.data() + start, head);
+    if (head < count)
+        visitor(m_storage.data(), count - head);
+}
+
+template <typename Handler>
+int SerialFrameParser::parse(Handler &&handler)
+{
+    int delivered = 0;
+    quint8 cmd = 0;
+    PayloadView payload;
+
+    // Frames are consumed before dispatching: the view stays valid because
+    // nothing writes into the ring while the handler runs, and a handler
+    // that closes the port (clear()) cannot corrupt the read index.
+    while (nextFrame(cmd, payload)) {
+        ++delivered;
+        handler(cmd, payload);
+    }
+
+    return delivered;
+}
+
+#endif // SERIALFRAMEPARSER_H
@@ -0,0 +1,155 @@
+#include "SerialIoWorker.h"
+#include "MonotonicClock.h"
+#include "PushCloneLogging.h"
+#include "TraceRing.h"
+#include "SerialCapture.h"
+
+#include <QThread>
+#include <QDebug>
+
+SerialIoWorker::SerialIoWorker(SerialRxQueue *queue, std::atomic_bool *drainPending)
+    : m_queue(queue)
+    , m_drainPending(drainPending)
+{
+}
+
+void SerialIoWorker::open(const QString &portName, int baudRate, quint64 generation)
+{
+    if (!m_serial) {
+        m_serial = new QSerialPort(this);
+        connect(m_serial, &QSerialPort::readyRead, this, &SerialIoWorker::handleReadyRead);
+        connect(m_serial, &QSerialPort::errorOccurred, this, &SerialIoWorker::handleError);
+    }
+
+    if (m_serial->isOpen())
+        m_serial->close();
+
+    m_parser.clear();
+    m_parser.setFramingVersion(SerialFrameParser::FramingV1);   // every session starts in v1
+    m_generation = generation;
+
+    m_serial->setPortName(portName);
+    m_serial->setBaudRate(baudRate);
+    m_serial->setDataBits(QSerialPort::Data8);
+    m_serial->setParity(QSerialPort::NoParity);
+    m_serial->setStopBits(QSerialPort::OneStop);
+    m_serial->setFlowControl(QSerialPort::NoFlowControl);
+
+    if (!m_serial->open(QIODevice::ReadWrite)) {
+        emit openFailed(tr("Unable to open %1: %2").arg(portName, m_serial->errorString()));
+        return;
+    }
+
+    emit opened();
+}
+
+void SerialIoWorker::close()
+{
+    if (m_serial && m_serial->isOpen())
+        m_serial->close();
+    m_parser.clear();
+}
+
+void SerialIoWorker::write(const QByteArray &batch)
+{
+    if (!m_serial || !m_serial->isOpen())
+        return;
+
+    const qint64 start = MonotonicClock::nowNs();
+    const qint64 written = m_serial->write(batch);
+    const qint64 stallNs = MonotonicClock::nowNs() - start;
+    if (written != batch.size())
+        PC_WARN(lcSerialTx) << "Failed to write complete batch" << written << "/" << batch.size();
+
+    // Only this thread writes the counters; the GUI reads them relaxed
+    m_txWrites.fetch_add(1, std::memory_order_relaxed);
+    m_txWriteStallTotalNs.fetch_add(stallNs, std::memory_order_relaxed);
+    if (stallNs > m_txWriteStallMaxNs.load(std::memory_order_relaxed))
+        m_txWriteStallMaxNs.store(stallNs, std::memory_order_relaxed);
+    m_txBacklogBytes.store(m_serial->bytesToWrite(), std::memory_order_relaxed);
+}
+
+void SerialIoWorker::setFramingVersion(int version)
+{
+    m_parser.setFramingVersion(SerialFrameParser::FramingVersion(version));
+}
+
+void SerialIoWorker::setBaudRate(int baudRate)
+{
+    if (m_serial && m_serial->isOpen() && !m_serial->setBaudRate(baudRate))
+        PC_WARN(lcSerial) << "Could not set baud rate" << baudRate << m_serial->errorString();
+    // Bytes straddling the switch are garbage at either rate
+    m_parser.clear();
+}
+
+void SerialIoWorker::resetTxStatistics()
+{
+    m_txWrites.store(0, std::memory_order_relaxed);
+    m_txWriteStallTotalNs.store(0, std::memory_order_relaxed);
+    m_txWriteStallMaxNs.store(0, std::memory_order_relaxed);
+}
+
+void SerialIoWorker::handleReadyRead()
+{
+    bool delivered = false;
+    qint64 received = 0;
+    do {
+        m_readNs = MonotonicClock::nowNs();
+        received = m_parser.readFrom(*m_serial);
+        if (received > 0) {
+            TraceRing::instance().record(TraceRing::RxChunk, 0, nullptr, int(received));
+            m_parser.visitLastWritten(int(received), SerialCapture::recordRx);
+        }
+        delivered |= m_parser.parse([this](quint8 cmd, const PayloadView &payload) {
+            enqueue(cmd, payload);
+        }) > 0;
+    } while (received > 0 && m_serial->isOpen() && m_serial->bytesAvailable() > 0);
+
+    m_checksumErrors.store(m_parser.checksumErrors(), std::memory_order_relaxed);
+    if (m_parser.framingFallbacks() != m_framingFallbacks.load(std::memory_order_relaxed)) {
+        m_framingFallbacks.store(m_parser.framingFallbacks(), std::memory_order_relaxed);
+        emit framingFallback();
+    }
+
+    // Wake the GUI only if it is not already scheduled to drain
+    if (delivered && !m_drainPending->exchange(true))
+        emit framesAvailable();
+}
+
+void SerialIoWorker::handleError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError)
+        return;
+
+    const QString message = tr("Serial error (%1): %2").arg(int(error)).arg(m_serial->errorString());
+    if (m_serial->isOpen())
+        m_serial->close();
+    m_parser.clear();
+    emit errorOccurred(message);
+}
+
+void SerialIoWorker::enqueue(quint8 cmd, const PayloadView &payload)
+{
+    TraceRing::instance().record(TraceRing::RxFrame, cmd, payload.data(), payload.size());
+
+    auto fill = [&](SerialRxEvent &event) {
+        event.generation = m_generation;
+        event.cmd = cmd;
+        event.size = quint16(payload.size());
+        std::memcpy(event.payload.data(), payload.data(), size_t(payload.size()));
+        event.timestampNs = MonotonicClock::nowNs();
+        event.rxNs = m_readNs;
+    };
+
+    // Back-pressure: the queue is full only if the GUI thread is stalled.
+    // Wait on this thread instead of dropping state updates; the port keeps
+    // buffering in the meantime.
+    while (!m_queue->tryEmplace(fill)) {
+        m_queueFullStalls.fetch_add(1, std::memory_order_relaxed);
+        if (!m_drainPending->exchange(true))
+            emit framesAvailable();
+        if (m_stopping.load())
+            return;
+        QThread::usleep(200);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef SERIALIOWORKER_H
+#define SERIALIOWORKER_H
+
+#include <QObject>
+#include <QSerialPort>
+#include <QByteArray>
+
+#include <atomic>
+
+#include "SerialFrameParser.h"
+#include "SpscQueue.h"
+
+// ═══════════════════════════════════════════════════════════
+// RX EVENT - One validated frame handed from the I/O thread to the GUI
+// ═══════════════════════════════════════════════════════════
+struct SerialRxEvent {
+    quint64 generation = 0;      // port session that produced the frame
+    qint64 timestampNs = 0;      // MonotonicClock at enqueue
+    qint64 rxNs = 0;             // MonotonicClock at the read that completed it
+    quint8 cmd = 0;
+    quint16 size = 0;
+    std::array<quint8, SerialFrameParser::MaxPayload> payload;
+
+    PayloadView view() const { return PayloadView(payload.data(), size); }
+};
+
+using SerialRxQueue = SpscQueue<SerialRxEvent, 256>;
+
+// ═══════════════════════════════════════════════════════════
+// SERIAL I/O WORKER - Port, framing and checksum on their own thread
+// ═══════════════════════════════════════════════════════════
+// Lives on a dedicated QThread. Validated frames go into the SPSC queue and
+// framesAvailable() fires at most once until the consumer clears
+// drainPending, so the GUI drains the queue once per event-loop turn.
+class SerialIoWorker : public QObject
+{
+    Q_OBJECT
+public:
+    SerialIoWorker(SerialRxQueue *queue, std::atomic_bool *drainPending);
+
+    void requestStop() { m_stopping.store(true); }
+    quint64 queueFullStalls() const { return m_queueFullStalls.load(std::memory_order_relaxed); }
+    quint64 checksumErrors() const { return m_checksumErrors.load(std::memory_order_relaxed); }
+    quint64 framingFallbacks() const { return m_framingFallbacks.load(std::memory_order_relaxed); }
+    quint64 txWrites() const { return m_txWrites.load(std::memory_order_relaxed); }
+    qint64 txWriteStallTotalNs() const { return m_txWriteStallTotalNs.load(std::memory_order_relaxed); }
+    qint64 txWriteStallMaxNs() const { return m_txWriteStallMaxNs.load(std::memory_order_relaxed); }
+    qint64 txBacklogBytes() const { return m_txBacklogBytes.load(std::memory_order_relaxed); }
+    void resetTxStatistics();
+
+public slots:
+    void open(const QString &portName, int baudRate, quint64 generation);
+    void close();
+    void write(const QByteArray &batch);
+    void setFramingVersion(int version);
+    void setBaudRate(int baudRate);
+
+signals:
+    void opened();
+    void openFailed(const QString &message);
+    void errorOccurred(const QString &message);
+    void framesAvailable();
+    void framingFallback();
+
+private slots:
+    void handleReadyRead();
+    void handleError(QSerialPort::SerialPortError error);
+
+private:
+    void enqueue(quint8 cmd, const PayloadView &payload);
+
+    QSerialPort *m_serial = nullptr;   // created on the worker thread
+    SerialFrameParser m_parser;
+    SerialRxQueue *m_queue = nullptr;
+    std::atomic_bool *m_drainPending = nullptr;
+    std::atomic_bool m_stopping { false };
+    std::atomic<quint64> m_queueFullStalls { 0 };
+    std::atomic<quint64> m_checksumErrors { 0 };
+    std::atomic<quint64> m_framingFallbacks { 0 };
+    std::atomic<quint64> m_txWrites { 0 };
+    std::atomic<qint64> m_txWriteStallTotalNs { 0 };
+    std::atomic<qint64> m_txWriteStallMaxNs { 0 };
+    std::atomic<qint64> m_txBacklogBytes { 0 };
+    quint64 m_generation = 0;
+    qint64 m_readNs = 0;               // stamp of the current readFrom()
+};
+
+#endif // SERIALIOWORKER_H
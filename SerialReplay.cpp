@@ -0,0 +1,82 @@
+#include "SerialReplay.h"
+#include "MonotonicClock.h"
+#include "PushCloneLogging.h"
+
+SerialReplay::SerialReplay(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &SerialReplay::deliverNext);
+}
+
+bool SerialReplay::start(const QString &path, Mode mode)
+{
+    stop();
+    if (!m_reader.open(path)) {
+        PC_WARN(lcSerial) << "Replay: cannot open" << path << m_reader.errorString();
+        return false;
+    }
+
+    m_mode = mode;
+    m_chunks = 0;
+    m_bytes = 0;
+    m_elapsedNs = 0;
+    m_hasPending = m_reader.next(m_pending);
+    m_firstTimestampNs = m_pending.timestampNs;
+    m_startNs = MonotonicClock::nowNs();
+    m_active = true;
+
+    PC_INFO(lcSerial) << "Replaying" << path << (mode == Realtime ? "in realtime" : "as fast as possible");
+    m_timer.start(0);
+    return true;
+}
+
+void SerialReplay::stop()
+{
+    m_timer.stop();
+    m_hasPending = false;
+    m_reader.close();
+    m_active = false;
+}
+
+void SerialReplay::deliverNext()
+{
+    int delivered = 0;
+
+    while (m_hasPending) {
+        if (m_mode == Realtime) {
+            const qint64 due = m_startNs + qint64((m_pending.timestampNs - m_firstTimestampNs) / m_speed);
+            const qint64 waitNs = due - MonotonicClock::nowNs();
+            if (waitNs > 1000000) {
+                m_timer.start(int(waitNs / 1000000));
+                return;
+            }
+        } else if (delivered >= FastBatchChunks) {
+            m_timer.start(0);
+            return;
+        }
+
+        if (m_sink)
+            m_sink(reinterpret_cast<const char *>(m_pending.data), m_pending.size);
+        ++m_chunks;
+        m_bytes += quint64(m_pending.size);
+        ++delivered;
+
+        // The sink may have stopped the replay
+        if (!m_active)
+            return;
+        m_hasPending = m_reader.next(m_pending);
+    }
+
+    finish();
+}
+
+void SerialReplay::finish()
+{
+    m_elapsedNs = MonotonicClock::nowNs() - m_startNs;
+    PC_INFO(lcSerial) << "Replay finished:" << m_chunks << "chunks," << m_bytes << "bytes in"
+                      << m_elapsedNs / 1000000.0 << "ms";
+    stop();
+    emit finished();
+}
@@ -0,0 +1,68 @@
+#ifndef SERIALREPLAY_H
+#define SERIALREPLAY_H
+
+#include <QObject>
+#include <QTimer>
+
+#include <functional>
+
+#include "SerialCapture.h"
+
+// ═══════════════════════════════════════════════════════════
+// SERIAL REPLAY - Feeds a capture back through the RX path
+// ═══════════════════════════════════════════════════════════
+// Realtime reproduces the recorded inter-chunk gaps (optionally scaled);
+// AsFastAsPossible delivers a batch of chunks per event-loop turn so the
+// GUI still renders while the stream is pushed through.
+class SerialReplay : public QObject
+{
+    Q_OBJECT
+public:
+    enum Mode {
+        Realtime,
+        AsFastAsPossible
+    };
+
+    using Sink = std::function<void(const char *data, int size)>;
+
+    static constexpr int FastBatchChunks = 64;
+
+    explicit SerialReplay(QObject *parent = nullptr);
+
+    void setSink(Sink sink) { m_sink = std::move(sink); }
+    void setSpeed(double speed) { m_speed = speed > 0.0 ? speed : 1.0; }
+
+    bool start(const QString &path, Mode mode);
+    void stop();
+    bool isActive() const { return m_active; }
+    QString errorString() const { return m_reader.errorString(); }
+
+    quint64 chunksReplayed() const { return m_chunks; }
+    quint64 bytesReplayed() const { return m_bytes; }
+    qint64 elapsedNs() const { return m_elapsedNs; }
+
+signals:
+    void finished();
+
+private slots:
+    void deliverNext();
+
+private:
+    void finish();
+
+    SerialCaptureReader m_reader;
+    SerialCaptureReader::Chunk m_pending;
+    bool m_hasPending = false;
+    Sink m_sink;
+    QTimer m_timer;
+    Mode m_mode = Realtime;
+    double m_speed = 1.0;
+    bool m_active = false;
+    qint64 m_firstTimestampNs = 0;
+    qint64 m_startNs = 0;
+    qint64 m_elapsedNs = 0;
+    quint64 m_chunks = 0;
+    quint64 m_bytes = 0;
+};
+
+#endif // SERIALREPLAY_H
@@ -0,0 +1,111 @@
+#include "SerialTxQueue.h"
+
+SerialTxQueue::SerialTxQueue()
+{
+    m_buffer.reserve(InitialCapacity);
+}
+
+void SerialTxQueue::enqueue(quint8 cmd, const quint8 *payload, int len)
+{
+    encodeFrame(m_buffer, cmd, payload, len, m_version);
+    ++m_pendingFrames;
+    ++m_framesQueued;
+    m_maxPendingFrames = qMax(m_maxPendingFrames, m_pendingFrames);
+    m_maxPendingBytes = qMax(m_maxPendingBytes, int(m_buffer.size()));
+}
+
+void SerialTxQueue::encodeFrame(QByteArray &out, quint8 cmd, const quint8 *payload, int len,
+                                SerialFrameParser::FramingVersion version)
+{
+    if (version == SerialFrameParser::FramingV2) {
+        encodeFrameV2(out, cmd, payload, len);
+        return;
+    }
+
+    Q_ASSERT(len >= 0 && len <= SerialFrameParser::MaxPayloadV1);
+    out.append(char(SerialFrameParser::FrameHeader));
+    out.append(char(cmd));
+    out.append(char(len));
+    out.append(reinterpret_cast<const char *>(payload), len);
+    out.append(char(SerialFrameParser::checksum(cmd, payload, len)));
+}
+
+void SerialTxQueue::encodeFrameV2(QByteArray &out, quint8 cmd, const quint8 *payload, int len)
+{
+    Q_ASSERT(len >= 0 && len <= SerialFrameParser::MaxPayload);
+
+    const quint8 header[SerialFrameParser::HeaderSizeV2] = { cmd, quint8(len >> 8), quint8(len & 0xFF) };
+    quint16 crc = SerialFrameParser::crc16(header, sizeof(header));
+    crc = SerialFrameParser::crc16(payload, len, crc);
+    const quint8 trailer[SerialFrameParser::CrcSize] = { quint8(crc >> 8), quint8(crc & 0xFF) };
+
+    // COBS straight into the output: worst case is one extra code byte per
+    // 254 bytes, so size for that and trim afterwards.
+    const int packetSize = SerialFrameParser::HeaderSizeV2 + len + SerialFrameParser::CrcSize;
+    const int start = int(out.size());
+    out.resize(start + packetSize + packetSize / 254 + 2);
+    quint8 *dst = reinterpret_cast<quint8 *>(out.data()) + start;
+
+    int codeAt = 0;
+    int at = 1;
+    quint8 code = 1;
+    auto put = [&](const quint8 *data, int count) {
+        for (int i = 0; i < count; ++i) {
+            if (data[i] == 0) {
+                dst[codeAt] = code;
+                codeAt = at++;
+                code = 1;
+                continue;
+            }
+            dst[at++] = data[i];
+            if (++code == 0xFF) {
+                dst[codeAt] = code;
+                codeAt = at++;
+                code = 1;
+            }
+        }
+    };
+    put(header, sizeof(header));
+    put(payload, len);
+    put(trailer, sizeof(trailer));
+    dst[codeAt] = code;
+    dst[at++] = SerialFrameParser::FrameDelimiterV2;
+
+    out.resize(start + at);
+}
+
+void SerialTxQueue::consume(qint64 count)
+{
+    if (count >= m_buffer.size()) {
+        // resize(0) keeps the reserved capacity for the next batch
+        m_buffer.resize(0);
+        m_pendingFrames = 0;
+        return;
+    }
+    if (count > 0)
+        m_buffer.remove(0, int(count));
+    // Partially written frame(s) still pending
+    m_pendingFrames = qMax(1, m_pendingFrames);
+}
+
+QByteArray SerialTxQueue::take()
+{
+    QByteArray batch;
+    batch.swap(m_buffer);
+    m_buffer.reserve(InitialCapacity);
+    m_pendingFrames = 0;
+    return batch;
+}
+
+void SerialTxQueue::clear()
+{
+    m_buffer.resize(0);
+    m_pendingFrames = 0;
+}
+
+void SerialTxQueue::resetStatistics()
+{
+    m_framesQueued = 0;
+    m_maxPendingFrames = m_pendingFrames;
+    m_maxPendingBytes = int(m_buffer.size());
+}
@@ -0,0 +1,59 @@
+#ifndef SERIALTXQUEUE_H
+#define SERIALTXQUEUE_H
+
+#include <QtGlobal>
+#include <QByteArray>
+
+#include "SerialFrameParser.h"
+
+// ═══════════════════════════════════════════════════════════
+// SERIAL TX QUEUE - Frames encoded into one reusable buffer
+// ═══════════════════════════════════════════════════════════
+// Frames are appended in call order and handed to the port as a single
+// write() per event-loop turn. Bytes the port did not accept stay at the
+// front of the buffer, so ordering is preserved across batches.
+class SerialTxQueue
+{
+public:
+    static constexpr int InitialCapacity = 4096;
+
+    SerialTxQueue();
+
+    // Appends one frame in the current framing to the pending buffer
+    void enqueue(quint8 cmd, const quint8 *payload, int len);
+    // Same framing into an arbitrary buffer (simulator, benchmarks)
+    static void encodeFrame(QByteArray &out, quint8 cmd, const quint8 *payload, int len,
+                            SerialFrameParser::FramingVersion version = SerialFrameParser::FramingV1);
+
+    // Applies to frames enqueued from now on; queued bytes keep their framing
+    SerialFrameParser::FramingVersion framingVersion() const { return m_version; }
+    void setFramingVersion(SerialFrameParser::FramingVersion version) { m_version = version; }
+
+    bool isEmpty() const { return m_buffer.isEmpty(); }
+    int pendingFrames() const { return m_pendingFrames; }
+    int pendingBytes() const { return int(m_buffer.size()); }
+    const QByteArray &buffer() const { return m_buffer; }
+
+    // Drops the first count bytes after they were handed to the device
+    void consume(qint64 count);
+    // Hands the whole pending buffer over (threaded I/O) and starts a new one
+    QByteArray take();
+    void clear();
+
+    quint64 framesQueued() const { return m_framesQueued; }
+    int maxPendingFrames() const { return m_maxPendingFrames; }
+    int maxPendingBytes() const { return m_maxPendingBytes; }
+    void resetStatistics();
+
+private:
+    static void encodeFrameV2(QByteArray &out, quint8 cmd, const quint8 *payload, int len);
+
+    QByteArray m_buffer;
+    SerialFrameParser::FramingVersion m_version = SerialFrameParser::FramingV1;
+    int m_pendingFrames = 0;
+    quint64 m_framesQueued = 0;
+    int m_maxPendingFrames = 0;
+    int m_maxPendingBytes = 0;
+};
+
+#endif // SERIALTXQUEUE_H
@@ -0,0 +1,117 @@
+#include "SessionCache.h"
+
+SessionCache::Clip *SessionCache::clipSlot(int track, int scene)
+{
+    if (!validIndex(track) || !validIndex(scene))
+        return nullptr;
+
+    const quint32 k = key(track, scene);
+    auto it = m_clips.find(k);
+    if (it != m_clips.end())
+        return &it.value();
+
+    if (m_clips.size() >= MaxClips) {
+        // Pathological set size: dropping everything is cheaper than LRU
+        // bookkeeping on every update, and the ring re-sends what it shows
+        m_clips.clear();
+        ++m_overflows;
+    }
+    return &m_clips[k];
+}
+
+void SessionCache::setClipName(int track, int scene, NamePool::Handle name)
+{
+    if (Clip *clip = clipSlot(track, scene)) {
+        clip->name = name;
+        clip->known |= HasName;
+    }
+}
+
+void SessionCache::setClipColor(int track, int scene, QRgb color)
+{
+    if (Clip *clip = clipSlot(track, scene)) {
+        clip->color = color;
+        clip->known |= HasColor;
+    }
+}
+
+void SessionCache::setClipState(int track, int scene, int state)
+{
+    if (Clip *clip = clipSlot(track, scene)) {
+        clip->state = quint8(state);
+        clip->known |= HasState;
+    }
+}
+
+const SessionCache::Clip *SessionCache::clip(int track, int scene) const
+{
+    if (!validIndex(track) || !validIndex(scene))
+        return nullptr;
+    auto it = m_clips.constFind(key(track, scene));
+    return it != m_clips.constEnd() ? &it.value() : nullptr;
+}
+
+void SessionCache::setTrackName(int track, NamePool::Handle name)
+{
+    if (!validIndex(track))
+        return;
+    Slot &slot = m_tracks[track];
+    slot.name = name;
+    slot.known |= HasName;
+}
+
+void SessionCache::setTrackColor(int track, QRgb color)
+{
+    if (!validIndex(track))
+        return;
+    Slot &slot = m_tracks[track];
+    slot.color = color;
+    slot.known |= HasColor;
+}
+
+const SessionCache::Slot *SessionCache::track(int track) const
+{
+    auto it = m_tracks.constFind(track);
+    return it != m_tracks.constEnd() ? &it.value() : nullptr;
+}
+
+void SessionCache::setSceneName(int scene, NamePool::Handle name)
+{
+    if (!validIndex(scene))
+        return;
+    Slot &slot = m_scenes[scene];
+    slot.name = name;
+    slot.known |= HasName;
+}
+
+void SessionCache::setSceneColor(int scene, QRgb color)
+{
+    if (!validIndex(scene))
+        return;
+    Slot &slot = m_scenes[scene];
+    slot.color = color;
+    slot.known |= HasColor;
+}
+
+const SessionCache::Slot *SessionCache::scene(int scene) const
+{
+    auto it = m_scenes.constFind(scene);
+    return it != m_scenes.constEnd() ? &it.value() : nullptr;
+}
+
+void SessionCache::clear()
+{
+    m_clips.clear();
+    m_tracks.clear();
+    m_scenes.clear();
+}
+
+void SessionCache::markNames(NamePool &pool) const
+{
+    for (const Clip &clip : m_clips)
+        pool.mark(clip.name);
+    for (const Slot &slot : m_tracks)
+        pool.mark(slot.name);
+    for (const Slot &slot : m_scenes)
+        pool.mark(slot.name);
+}
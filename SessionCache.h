@@ -0,0 +1,81 @@
+#ifndef SESSIONCACHE_H
+#define SESSIONCACHE_H
+
+#include <QtGlobal>
+#include <QColor>
+#include <QHash>
+
+#include "NamePool.h"
+
+// ═══════════════════════════════════════════════════════════
+// SESSION CACHE - Last known clip/track/scene data by absolute index
+// ═══════════════════════════════════════════════════════════
+// The models only hold the visible 8x4 session ring. Everything the Teensy
+// sends is also kept here keyed by absolute (track, scene), including cells
+// outside the ring, so a ring move can repaint the new window at once
+// instead of blanking it until the bulk re-send arrives. Only fields that
+// were actually received are marked known.
+//
+// Sparse: a few thousand cells for a typical Live set. Cleared when the
+// link drops (the set on the other end may have changed).
+class SessionCache
+{
+public:
+    enum Field : quint8 {
+        HasName = 1 << 0,
+        HasColor = 1 << 1,
+        HasState = 1 << 2
+    };
+
+    struct Clip {
+        NamePool::Handle name = NamePool::Empty;
+        QRgb color = 0;
+        quint8 state = 0;
+        quint8 known = 0;
+    };
+
+    // Tracks and scenes
+    struct Slot {
+        NamePool::Handle name = NamePool::Empty;
+        QRgb color = 0;
+        quint8 known = 0;
+    };
+
+    static constexpr int MaxClips = 1 << 16;   // beyond this start over
+
+    void setClipName(int track, int scene, NamePool::Handle name);
+    void setClipColor(int track, int scene, QRgb color);
+    void setClipState(int track, int scene, int state);
+    // nullptr if nothing was ever received for the cell
+    const Clip *clip(int track, int scene) const;
+
+    void setTrackName(int track, NamePool::Handle name);
+    void setTrackColor(int track, QRgb color);
+    const Slot *track(int track) const;
+
+    void setSceneName(int scene, NamePool::Handle name);
+    void setSceneColor(int scene, QRgb color);
+    const Slot *scene(int scene) const;
+    // Deleted in Live: back to unknown, so the ring shows the placeholder
+    void forgetScene(int scene) { m_scenes.remove(scene); }
+
+    void clear();
+    void markNames(NamePool &pool) const;
+
+    int clipCount() const { return m_clips.size(); }
+    int trackCount() const { return m_tracks.size(); }
+    int sceneCount() const { return m_scenes.size(); }
+    quint64 overflows() const { return m_overflows; }
+
+private:
+    static bool validIndex(int index) { return index >= 0 && index < 0x10000; }
+    static quint32 key(int track, int scene) { return (quint32(track) << 16) | quint32(scene); }
+    Clip *clipSlot(int track, int scene);
+
+    QHash<quint32, Clip> m_clips;
+    QHash<int, Slot> m_tracks;
+    QHash<int, Slot> m_scenes;
+    quint64 m_overflows = 0;
+};
+
+#endif // SESSIONCACHE_H
@@ -0,0 +1,63 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+
+// ═══════════════════════════════════════════════════════════
+// SPSC QUEUE - Bounded lock-free single-producer/single-consumer ring
+// ═══════════════════════════════════════════════════════════
+// One thread may call tryEmplace(), one other thread front()/pop().
+// Slots are filled and read in place, so large items are never copied.
+template <typename T, int Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+public:
+    // Producer: fill(T &slot) writes the item directly into the queue.
+    template <typename Fill>
+    bool tryEmplace(Fill &&fill)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= quint32(Capacity))
+            return false;
+        fill(m_slots[tail & Mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: oldest item or nullptr when empty. Valid until pop().
+    T *front()
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &m_slots[head & Mask];
+    }
+
+    void pop()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Approximate when read from the producer side
+    int size() const
+    {
+        return int(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+    }
+
+    static constexpr int capacity() { return Capacity; }
+
+private:
+    static constexpr quint32 Mask = quint32(Capacity) - 1;
+
+    alignas(64) std::atomic<quint32> m_head { 0 };   // consumer index
+    alignas(64) std::atomic<quint32> m_tail { 0 };   // producer index
+    std::array<T, Capacity> m_slots;
+};
+
+#endif // SPSCQUEUE_H
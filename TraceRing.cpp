@@ -0,0 +1,87 @@
+#include "TraceRing.h"
+#include "MonotonicClock.h"
+
+#include <QFile>
+#include <QVector>
+
+#include <cstring>
+
+TraceRing &TraceRing::instance()
+{
+    static TraceRing ring;
+    return ring;
+}
+
+TraceRing::TraceRing()
+{
+    m_enabled.store(qEnvironmentVariableIntValue("PUSHCLONE_TRACE_OFF") == 0);
+}
+
+void TraceRing::record(Kind kind, quint8 cmd, const quint8 *payload, int len) noexcept
+{
+    if (!m_enabled.load(std::memory_order_relaxed))
+        return;
+
+    const quint64 sequence = m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = m_slots[sequence & Mask];
+
+    slot.state.store(sequence * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Record &r = slot.record;
+    r.sequence = sequence;
+    r.timestampNs = MonotonicClock::nowNs();
+    r.kind = kind;
+    r.cmd = cmd;
+    r.len = quint16(len);
+    const int preview = payload ? qMin(len, int(PreviewBytes)) : 0;
+    if (preview > 0)
+        std::memcpy(r.preview, payload, size_t(preview));
+    std::memset(r.preview + preview, 0, size_t(PreviewBytes - preview));
+
+    slot.state.store(sequence * 2 + 2, std::memory_order_release);
+}
+
+int TraceRing::snapshot(Record *out, int maxRecords) const
+{
+    const quint64 head = m_head.load(std::memory_order_acquire);
+    const quint64 available = qMin<quint64>(head, quint64(qMin(maxRecords, int(Capacity))));
+    int copied = 0;
+
+    for (quint64 sequence = head - available; sequence < head; ++sequence) {
+        const Slot &slot = m_slots[sequence & Mask];
+        const quint64 before = slot.state.load(std::memory_order_acquire);
+        if (before != sequence * 2 + 2)
+            continue;   // still being written, or already lapped
+        Record copy;
+        std::memcpy(&copy, &slot.record, sizeof(Record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.state.load(std::memory_order_relaxed) != before)
+            continue;
+        out[copied++] = copy;
+    }
+
+    return copied;
+}
+
+bool TraceRing::dumpToFile(const QString &path) const
+{
+    QVector<Record> records(Capacity);
+    const int count = snapshot(records.data(), Capacity);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "PCTRACE", 8);
+    header.version = FileVersion;
+    header.recordSize = sizeof(Record);
+    header.recordCount = quint64(count);
+    header.dumpTimestampNs = MonotonicClock::nowNs();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    if (file.write(reinterpret_cast<const char *>(&header), sizeof(header)) != qint64(sizeof(header)))
+        return false;
+    const qint64 bytes = qint64(count) * qint64(sizeof(Record));
+    return file.write(reinterpret_cast<const char *>(records.constData()), bytes) == bytes;
+}
@@ -0,0 +1,82 @@
+#ifndef TRACERING_H
+#define TRACERING_H
+
+#include <QtGlobal>
+#include <QString>
+
+#include <array>
+#include <atomic>
+
+// ═══════════════════════════════════════════════════════════
+// TRACE RING - Lock-free binary log of frame metadata
+// ═══════════════════════════════════════════════════════════
+// Records timestamp, direction, cmd, len and the first payload bytes into a
+// fixed ring without formatting anything. Any thread may record (RX on the
+// I/O thread, TX on the GUI thread); each slot carries a sequence number so
+// a snapshot skips slots that are being overwritten.
+//
+// dumpToFile() writes the ring as-is; tools/trace_decode renders it to text.
+class TraceRing
+{
+public:
+    enum Kind : quint8 {
+        RxFrame = 1,        // validated frame
+        TxFrame = 2,        // frame queued for transmission
+        RxChunk = 3,        // bytes read from the device (len = byte count)
+        RxRejected = 4,     // unknown command or length out of bounds
+        RxChecksumError = 5
+    };
+
+    static constexpr int Capacity = 4096;      // must be a power of two
+    static constexpr int PreviewBytes = 12;
+
+    // On-disk record layout, native endianness (little-endian on Pi and x86)
+    struct Record {
+        quint64 sequence;
+        qint64 timestampNs;    // MonotonicClock
+        quint8 kind;
+        quint8 cmd;
+        quint16 len;
+        quint8 preview[PreviewBytes];
+    };
+    static_assert(sizeof(Record) == 32, "Record layout is part of the dump format");
+
+    struct FileHeader {
+        char magic[8];         // "PCTRACE\0"
+        quint32 version;
+        quint32 recordSize;
+        quint64 recordCount;
+        qint64 dumpTimestampNs;
+    };
+    static constexpr quint32 FileVersion = 1;
+
+    static TraceRing &instance();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void record(Kind kind, quint8 cmd, const quint8 *payload, int len) noexcept;
+
+    // Copies consistent records, oldest first. Returns the number copied.
+    int snapshot(Record *out, int maxRecords) const;
+    bool dumpToFile(const QString &path) const;
+
+    quint64 recorded() const { return m_head.load(std::memory_order_relaxed); }
+
+private:
+    TraceRing();
+
+    static constexpr quint64 Mask = Capacity - 1;
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    struct Slot {
+        std::atomic<quint64> state { 0 };   // 2*seq+1 while writing, 2*seq+2 when done
+        Record record;
+    };
+
+    std::array<Slot, Capacity> m_slots;
+    alignas(64) std::atomic<quint64> m_head { 0 };
+    std::atomic_bool m_enabled { true };
+};
+
+#endif // TRACERING_H
@@ -35,7 +35,7 @@ QVariant TrackListModel::data(const QModelIndex &index, int role) const
     case IndexRole:
         return track.index;
     case NameRole:
-        return track.name;
+        return NamePool::instance().name(track.name);
     case ColorRole:
         return track.color;
     case ActiveRole:
@@ -55,12 +55,12 @@ QHash<int, QByteArray> TrackListModel::roleNames() const
     };
 }
 
-void TrackListModel::setTrackName(int index, const QString &name)
+void TrackListModel::setTrackName(int index, NamePool::Handle name)
 {
     if (!validIndex(index))
         return;
     TrackInfo &track = m_tracks[index];
-    const bool hasData = !name.isEmpty();
+    const bool hasData = name != NamePool::Empty;
     QVector<int> roles;
 
     if (track.name != name) {
@@ -82,8 +82,7 @@ void TrackListModel::setTrackName(int index, const QString &name)
     if (roles.isEmpty())
         return;
 
-    const QModelIndex modelIndex = this->index(index, 0);
-    emit dataChanged(modelIndex, modelIndex, roles);
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index, ModelUpdateCoalescer::roleMask(roles));
 }
 
 void TrackListModel::setTrackColor(int index, const QColor &color)
@@ -96,8 +95,8 @@ void TrackListModel::setTrackColor(int index, const QColor &color)
     track.color = color;
     if (color != kEmptyTrackColor && !track.active)
         track.active = true;
-    const QModelIndex modelIndex = this->index(index, 0);
-    emit dataChanged(modelIndex, modelIndex, { ColorRole, ActiveRole });
+    ModelUpdateCoalescer::notify(m_coalescer, this, index, index,
+                                 ModelUpdateCoalescer::roleMask({ ColorRole, ActiveRole }));
 }
 
 void TrackListModel::resetAll()
@@ -106,14 +105,12 @@ void TrackListModel::resetAll()
         return;
 
     for (TrackInfo &track : m_tracks) {
-        track.name.clear();
+        track.name = NamePool::Empty;
         track.color = kEmptyTrackColor;
         track.active = false;
     }
 
-    const QModelIndex first = this->index(0, 0);
-    const QModelIndex last = this->index(m_tracks.size() - 1, 0);
-    emit dataChanged(first, last);
+    ModelUpdateCoalescer::notify(m_coalescer, this, 0, m_tracks.size() - 1, ModelUpdateCoalescer::AllRoles);
 }
 
 void TrackListModel::clearAbove(int lastActiveIndex)
@@ -128,19 +125,22 @@ void TrackListModel::clearAbove(int lastActiveIndex)
     bool changed = false;
     for (int i = start; i < m_tracks.size(); ++i) {
         TrackInfo &track = m_tracks[i];
-        if (!track.active && track.name.isEmpty() && track.color == kEmptyTrackColor)
+        if (!track.active && track.name == NamePool::Empty && track.color == kEmptyTrackColor)
             continue;
-        track.name.clear();
+        track.name = NamePool::Empty;
         track.color = kEmptyTrackColor;
         track.active = false;
         changed = true;
     }
 
-    if (changed) {
-        const QModelIndex first = this->index(start, 0);
-        const QModelIndex last = this->index(m_tracks.size() - 1, 0);
-        emit dataChanged(first, last);
-    }
+    if (changed)
+        ModelUpdateCoalescer::notify(m_coalescer, this, start, m_tracks.size() - 1, ModelUpdateCoalescer::AllRoles);
+}
+
+void TrackListModel::markNames(NamePool &pool) const
+{
+    for (const TrackInfo &track : m_tracks)
+        pool.mark(track.name);
 }
 
 bool TrackListModel::validIndex(int index) const
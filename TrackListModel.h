@@ -6,9 +6,12 @@
 #include <QVector>
 #include <QString>
 
+#include "ModelUpdateCoalescer.h"
+#include "NamePool.h"
+
 struct TrackInfo {
     int index = 0;
-    QString name;
+    NamePool::Handle name = NamePool::Empty;
     QColor color = QColor("#2a2a2a");
     bool active = false;
 };
@@ -31,14 +34,19 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
-    void setTrackName(int index, const QString &name);
+    void setTrackName(int index, NamePool::Handle name);
+    void setTrackName(int index, const QString &name) { setTrackName(index, NamePool::instance().intern(name)); }
     void setTrackColor(int index, const QColor &color);
     void resetAll();
     void clearAbove(int lastActiveIndex);
+    void markNames(NamePool &pool) const;
+
+    void setCoalescer(ModelUpdateCoalescer *coalescer) { m_coalescer = coalescer; }
 
 private:
     bool validIndex(int index) const;
     QVector<TrackInfo> m_tracks;
+    ModelUpdateCoalescer *m_coalescer = nullptr;
 };
 
 #endif // TRACKLISTMODEL_H
@@ -0,0 +1,142 @@
+#include "UpdateLatencyTracer.h"
+#include "ProtocolSchema.h"
+
+#include <QFile>
+#include <QTextStream>
+
+void UpdateLatencyTracer::beginDispatch(quint8 cmd, qint64 rxNs, qint64 nowNs)
+{
+    if (!m_enabled || rxNs == 0)
+        return;
+
+    m_dispatching = true;
+    m_cmd = cmd;
+    m_rxNs = rxNs;
+    m_dispatchNs = nowNs;
+    m_modelNs = 0;
+    histogramFor(cmd, Parse).record(quint64(qMax<qint64>(0, nowNs - rxNs)) / 1000);
+}
+
+void UpdateLatencyTracer::endDispatch()
+{
+    if (!m_dispatching)
+        return;
+    m_dispatching = false;
+    if (m_modelNs == 0)
+        return;   // nothing visible changed
+
+    histogramFor(m_cmd, Model).record(quint64(qMax<qint64>(0, m_modelNs - m_dispatchNs)) / 1000);
+
+    if (m_pendingCount == MaxPending) {
+        ++m_pendingOverflows;   // no frame for a long burst; keep the oldest
+        return;
+    }
+    m_pending[m_pendingCount++] = Pending { m_cmd, m_rxNs, m_modelNs };
+}
+
+void UpdateLatencyTracer::frameSwapped(qint64 nowNs)
+{
+    ++m_framesSwapped;
+    for (int i = 0; i < m_pendingCount; ++i) {
+        const Pending &p = m_pending[i];
+        if (nowNs - p.modelNs > StaleNs) {
+            // Off-screen delegate or an unchanged value: no repaint was due
+            ++m_staleUpdates;
+            continue;
+        }
+        histogramFor(p.cmd, Render).record(quint64(qMax<qint64>(0, nowNs - p.modelNs)) / 1000);
+        histogramFor(p.cmd, Total).record(quint64(qMax<qint64>(0, nowNs - p.rxNs)) / 1000);
+    }
+    m_pendingCount = 0;
+}
+
+LatencyHistogram &UpdateLatencyTracer::histogramFor(quint8 cmd, Stage stage)
+{
+    std::unique_ptr<CommandHistograms> &slot = m_commands[cmd];
+    if (!slot)
+        slot.reset(new CommandHistograms());
+    return (*slot)[stage];
+}
+
+const LatencyHistogram *UpdateLatencyTracer::histogram(quint8 cmd, Stage stage) const
+{
+    const std::unique_ptr<CommandHistograms> &slot = m_commands[cmd];
+    return slot ? &(*slot)[stage] : nullptr;
+}
+
+QVariantMap UpdateLatencyTracer::statistics() const
+{
+    QVariantMap commands;
+    for (int cmd = 0; cmd < 256; ++cmd) {
+        if (!m_commands[cmd])
+            continue;
+        QVariantMap stages;
+        for (int stage = 0; stage < StageCount; ++stage) {
+            const LatencyHistogram &h = (*m_commands[cmd])[stage];
+            if (!h.count())
+                continue;
+            QVariantMap values;
+            values.insert(QStringLiteral("count"), h.count());
+            values.insert(QStringLiteral("p50Us"), h.percentile(50.0));
+            values.insert(QStringLiteral("p99Us"), h.percentile(99.0));
+            values.insert(QStringLiteral("maxUs"), h.max());
+            stages.insert(QString::fromLatin1(stageName(Stage(stage))), values);
+        }
+        commands.insert(commandKey(quint8(cmd)), stages);
+    }
+    return commands;
+}
+
+void UpdateLatencyTracer::reset()
+{
+    for (std::unique_ptr<CommandHistograms> &slot : m_commands)
+        slot.reset();
+    m_dispatching = false;
+    m_pendingCount = 0;
+    m_framesSwapped = 0;
+    m_pendingOverflows = 0;
+    m_staleUpdates = 0;
+}
+
+bool UpdateLatencyTracer::dumpToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream out(&file);
+    out << "# Update latency (ms) - frames swapped " << m_framesSwapped
+        << ", pending overflows " << m_pendingOverflows << ", stale updates " << m_staleUpdates << "\n";
+    for (int cmd = 0; cmd < 256; ++cmd) {
+        if (!m_commands[cmd])
+            continue;
+        for (int stage = 0; stage < StageCount; ++stage) {
+            const LatencyHistogram &h = (*m_commands[cmd])[stage];
+            if (!h.count())
+                continue;
+            out << "\n# " << commandKey(quint8(cmd)) << ' ' << stageName(Stage(stage)) << "\n";
+            h.writeTo(out, 1000.0);
+        }
+    }
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+const char *UpdateLatencyTracer::stageName(Stage stage)
+{
+    switch (stage) {
+    case Parse: return "parse";
+    case Model: return "model";
+    case Render: return "render";
+    case Total: return "total";
+    case StageCount: break;
+    }
+    return "?";
+}
+
+QString UpdateLatencyTracer::commandKey(quint8 cmd)
+{
+    const char *name = Protocol::commandName(cmd);
+    return name ? QString::fromLatin1(name)
+                : QStringLiteral("0x%1").arg(cmd, 2, 16, QLatin1Char('0'));
+}
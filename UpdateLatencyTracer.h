@@ -0,0 +1,90 @@
+#ifndef UPDATELATENCYTRACER_H
+#define UPDATELATENCYTRACER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVariantMap>
+
+#include <array>
+#include <memory>
+
+#include "LatencyHistogram.h"
+
+// ═══════════════════════════════════════════════════════════
+// UPDATE LATENCY TRACER - Byte arrival → model → rendered frame
+// ═══════════════════════════════════════════════════════════
+// Per command ID, four distributions in microseconds:
+//   parse   readyRead → handler dispatch (framing, I/O thread hand-off)
+//   model   dispatch → first dataChanged the handler caused
+//   render  that dataChanged → next QQuickWindow::frameSwapped
+//   total   readyRead → frameSwapped, what the user actually waits
+// Frames whose handler changed no model only get a parse sample.
+//
+// GUI thread only: frameSwapped() relies on the basic render loop
+// (QSG_RENDER_LOOP=basic, set in main.cpp) emitting on the GUI thread.
+class UpdateLatencyTracer
+{
+public:
+    enum Stage { Parse, Model, Render, Total, StageCount };
+
+    static constexpr int MaxPending = 512;                   // updates awaiting a frame
+    static constexpr qint64 StaleNs = 1000 * 1000 * 1000;    // nothing repainted in 1 s
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // Bracket one handler call; modelChanged() is hooked to the models'
+    // change signals and only stamps the first one in between.
+    void beginDispatch(quint8 cmd, qint64 rxNs, qint64 nowNs);
+    void modelChanged(qint64 nowNs)
+    {
+        if (m_dispatching && m_modelNs == 0)
+            m_modelNs = nowNs;
+    }
+    bool dispatching() const { return m_dispatching; }
+    void endDispatch();
+
+    void frameSwapped(qint64 nowNs);
+
+    // nullptr until the command has been seen
+    const LatencyHistogram *histogram(quint8 cmd, Stage stage) const;
+    quint64 framesSwapped() const { return m_framesSwapped; }
+    quint64 pendingOverflows() const { return m_pendingOverflows; }
+    quint64 staleUpdates() const { return m_staleUpdates; }
+
+    // { "<COMMAND>": { "<stage>": { count, p50Us, p99Us, maxUs } } }
+    QVariantMap statistics() const;
+    void reset();
+    // One .hgrm section per command and stage, values in milliseconds
+    bool dumpToFile(const QString &path) const;
+
+    static const char *stageName(Stage stage);
+
+private:
+    struct Pending {
+        quint8 cmd;
+        qint64 rxNs;
+        qint64 modelNs;
+    };
+    using CommandHistograms = std::array<LatencyHistogram, StageCount>;
+
+    LatencyHistogram &histogramFor(quint8 cmd, Stage stage);
+    static QString commandKey(quint8 cmd);
+
+    bool m_enabled = true;
+    bool m_dispatching = false;
+    quint8 m_cmd = 0;
+    qint64 m_rxNs = 0;
+    qint64 m_dispatchNs = 0;
+    qint64 m_modelNs = 0;
+
+    // Allocated on first use: only a handful of command IDs ever show up
+    std::array<std::unique_ptr<CommandHistograms>, 256> m_commands;
+    std::array<Pending, MaxPending> m_pending {};
+    int m_pendingCount = 0;
+    quint64 m_framesSwapped = 0;
+    quint64 m_pendingOverflows = 0;
+    quint64 m_staleUpdates = 0;
+};
+
+#endif // UPDATELATENCYTRACER_H
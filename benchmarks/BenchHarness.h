@@ -0,0 +1,195 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+// Minimal benchmark harness shared by the benchmarks/ executables.
+//
+// Every case runs `repeat` times; the median and best ns/op are reported.
+// Output is text (default), --format json or --format csv, optionally to
+// --output <file>, so release builds on the Pi 5 can be diffed run to run.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+
+template <typename T>
+inline void benchDoNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+class BenchSuite
+{
+public:
+    struct Result {
+        QString name;
+        qint64 iterations = 0;
+        double nsPerOpMedian = 0.0;
+        double nsPerOpMin = 0.0;
+        double bytesPerOp = 0.0;    // > 0: MB/s is reported too
+        double itemsPerOp = 0.0;    // frames, emissions, ... per op
+    };
+
+    BenchSuite(const QString &suite, const QCoreApplication &app)
+        : m_suite(suite)
+    {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(QStringLiteral("PushClone benchmark: %1").arg(suite));
+        parser.addHelpOption();
+        QCommandLineOption formatOption(QStringLiteral("format"), QStringLiteral("text, json or csv"),
+                                        QStringLiteral("format"), QStringLiteral("text"));
+        QCommandLineOption outputOption(QStringLiteral("output"), QStringLiteral("Write results to file"),
+                                        QStringLiteral("file"));
+        QCommandLineOption filterOption(QStringLiteral("filter"), QStringLiteral("Regex on case names"),
+                                        QStringLiteral("regex"));
+        QCommandLineOption repeatOption(QStringLiteral("repeat"), QStringLiteral("Repetitions per case"),
+                                        QStringLiteral("n"), QStringLiteral("5"));
+        QCommandLineOption scaleOption(QStringLiteral("scale"), QStringLiteral("Iteration multiplier"),
+                                       QStringLiteral("factor"), QStringLiteral("1"));
+        parser.addOptions({ formatOption, outputOption, filterOption, repeatOption, scaleOption });
+        parser.process(app);
+
+        m_format = parser.value(formatOption);
+        m_output = parser.value(outputOption);
+        m_filter = QRegularExpression(parser.value(filterOption));
+        m_repeat = qMax(1, parser.value(repeatOption).toInt());
+        m_scale = qMax(0.001, parser.value(scaleOption).toDouble());
+    }
+
+    bool selected(const QString &name) const
+    {
+        return m_filter.pattern().isEmpty() || m_filter.match(name).hasMatch();
+    }
+
+    // fn() is one operation; it runs `iterations` times per repetition
+    template <typename Fn>
+    void run(const QString &name, qint64 iterations, Fn &&fn, double bytesPerOp = 0.0, double itemsPerOp = 0.0)
+    {
+        if (!selected(name))
+            return;
+
+        iterations = qMax<qint64>(1, qint64(iterations * m_scale));
+        for (qint64 i = 0; i < qMin<qint64>(iterations, 1000); ++i)
+            fn();   // warm caches and lazily-built tables
+
+        QVector<double> samples;
+        samples.reserve(m_repeat);
+        for (int r = 0; r < m_repeat; ++r) {
+            QElapsedTimer timer;
+            timer.start();
+            for (qint64 i = 0; i < iterations; ++i)
+                fn();
+            samples.append(double(timer.nsecsElapsed()) / double(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.nsPerOpMedian = samples.at(samples.size() / 2);
+        result.nsPerOpMin = samples.first();
+        result.bytesPerOp = bytesPerOp;
+        result.itemsPerOp = itemsPerOp;
+        m_results.append(result);
+    }
+
+    // Overrides itemsPerOp of the last case, for counts only known afterwards
+    void setLastItemsPerOp(double itemsPerOp)
+    {
+        if (!m_results.isEmpty())
+            m_results.last().itemsPerOp = itemsPerOp;
+    }
+
+    int finish() const
+    {
+        QString text;
+        QTextStream out(&text);
+
+        if (m_format == QLatin1String("json")) {
+            QJsonArray results;
+            for (const Result &r : m_results) {
+                QJsonObject o;
+                o.insert(QStringLiteral("name"), r.name);
+                o.insert(QStringLiteral("iterations"), double(r.iterations));
+                o.insert(QStringLiteral("ns_per_op_median"), r.nsPerOpMedian);
+                o.insert(QStringLiteral("ns_per_op_min"), r.nsPerOpMin);
+                if (r.bytesPerOp > 0)
+                    o.insert(QStringLiteral("mb_per_s"), mbPerSecond(r));
+                if (r.itemsPerOp > 0)
+                    o.insert(QStringLiteral("items_per_op"), r.itemsPerOp);
+                results.append(o);
+            }
+            QJsonObject root;
+            root.insert(QStringLiteral("suite"), m_suite);
+            root.insert(QStringLiteral("qt"), QString::fromLatin1(qVersion()));
+            root.insert(QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture());
+            root.insert(QStringLiteral("kernel"), QSysInfo::kernelVersion());
+            root.insert(QStringLiteral("repeat"), m_repeat);
+            root.insert(QStringLiteral("results"), results);
+            out << QJsonDocument(root).toJson(QJsonDocument::Indented);
+        } else if (m_format == QLatin1String("csv")) {
+            out << "suite,name,iterations,ns_per_op_median,ns_per_op_min,mb_per_s,items_per_op\n";
+            for (const Result &r : m_results) {
+                out << m_suite << ',' << r.name << ',' << r.iterations << ','
+                    << QString::number(r.nsPerOpMedian, 'f', 2) << ','
+                    << QString::number(r.nsPerOpMin, 'f', 2) << ','
+                    << (r.bytesPerOp > 0 ? QString::number(mbPerSecond(r), 'f', 2) : QString()) << ','
+                    << (r.itemsPerOp > 0 ? QString::number(r.itemsPerOp, 'f', 2) : QString()) << '\n';
+            }
+        } else {
+            out << m_suite << " (" << QSysInfo::currentCpuArchitecture() << ", Qt " << qVersion()
+                << ", median of " << m_repeat << ")\n";
+            for (const Result &r : m_results) {
+                out << QStringLiteral("  %1 %2 ns/op").arg(r.name, -36).arg(r.nsPerOpMedian, 12, 'f', 1);
+                if (r.bytesPerOp > 0)
+                    out << QStringLiteral("  %1 MB/s").arg(mbPerSecond(r), 9, 'f', 1);
+                if (r.itemsPerOp > 0)
+                    out << QStringLiteral("  %1 items/op").arg(r.itemsPerOp, 0, 'f', 1);
+                out << '\n';
+            }
+        }
+        out.flush();
+
+        if (m_output.isEmpty()) {
+            QTextStream(stdout) << text;
+            return 0;
+        }
+        QFile file(m_output);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            QTextStream(stderr) << "Cannot write " << m_output << "\n";
+            return 1;
+        }
+        file.write(text.toUtf8());
+        return 0;
+    }
+
+private:
+    static double mbPerSecond(const Result &r)
+    {
+        return r.bytesPerOp / r.nsPerOpMedian * 1e9 / 1e6;
+    }
+
+    QString m_suite;
+    QString m_format;
+    QString m_output;
+    QRegularExpression m_filter;
+    int m_repeat = 5;
+    double m_scale = 1.0;
+    QVector<Result> m_results;
+};
+
+#endif // BENCHHARNESS_H
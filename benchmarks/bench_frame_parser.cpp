@@ -0,0 +1,189 @@
+// Parser throughput: legacy QByteArray framing vs SerialFrameParser ring.
+//
+// Build with -DPUSHCLONE_BUILD_BENCHMARKS=ON and run on the target (Pi 5):
+//   ./benchFrameParser [iterations]
+
+#include <QCoreApplication>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QVector>
+
+#include <cstdio>
+
+#include "SerialFrameParser.h"
+
+namespace {
+
+constexpr quint8 FrameHeader = 0xAA;
+constexpr int ChunkSize = 64;  // typical readyRead chunk from the UART driver
+
+QByteArray encodeFrame(quint8 cmd, const QByteArray &payload)
+{
+    QByteArray frame;
+    frame.append(char(FrameHeader));
+    frame.append(char(cmd));
+    frame.append(char(payload.size()));
+    frame.append(payload);
+    frame.append(char(SerialFrameParser::checksum(
+        cmd, reinterpret_cast<const quint8 *>(payload.constData()), payload.size())));
+    return frame;
+}
+
+// Ring-move burst: bulk clips + bulk metadata + a few mixer updates
+QByteArray buildBurst()
+{
+    QByteArray stream;
+
+    QByteArray clips;
+    for (int i = 0; i < 32; ++i) {
+        clips.append(char(i % 4));
+        clips.append(char((i * 3) & 0x7F));
+        clips.append(char((i * 5) & 0x7F));
+        clips.append(char((i * 7) & 0x7F));
+    }
+    stream.append(encodeFrame(0x9B, clips));
+
+    QByteArray metadata;
+    metadata.append(char(8));
+    for (int t = 0; t < 8; ++t) {
+        const QByteArray name = QByteArray("Track ") + QByteArray::number(t + 1);
+        metadata.append(char(name.size()));
+        metadata.append(name);
+        metadata.append(char(0x40)).append(char(0x20)).append(char(0x10));
+    }
+    metadata.append(char(4));
+    for (int s = 0; s < 4; ++s) {
+        const QByteArray name = QByteArray("Scene ") + QByteArray::number(s + 1);
+        metadata.append(char(name.size()));
+        metadata.append(name);
+        metadata.append(char(0x10)).append(char(0x20)).append(char(0x40));
+    }
+    stream.append(encodeFrame(0x9A, metadata));
+
+    for (int t = 0; t < 8; ++t) {
+        QByteArray volume;
+        volume.append(char(t)).append(char(0x60)).append(char(t * 9));
+        stream.append(encodeFrame(0x21, volume));
+    }
+
+    return stream;
+}
+
+// Verbatim copy of the pre-ring SerialController::handleReadyRead framing
+struct LegacyParser
+{
+    QByteArray buffer;
+    quint64 checksumSink = 0;
+
+    int feed(const QByteArray &chunk)
+    {
+        int frames = 0;
+        buffer.append(chunk);
+
+        while (true) {
+            const int syncIndex = buffer.indexOf(char(FrameHeader));
+            if (syncIndex < 0) {
+                buffer.clear();
+                break;
+            }
+            if (syncIndex > 0)
+                buffer.remove(0, syncIndex);
+            if (buffer.size() < 3)
+                break;
+
+            const quint8 cmd = quint8(buffer.at(1));
+            const quint8 len = quint8(buffer.at(2));
+            const int totalSize = 3 + len + 1;
+            if (buffer.size() < totalSize)
+                break;
+
+            const QByteArray payload = buffer.mid(3, len);
+            const quint8 checksum = quint8(buffer.at(3 + len));
+            if (checksum != SerialFrameParser::checksum(
+                    cmd, reinterpret_cast<const quint8 *>(payload.constData()), len)) {
+                buffer.remove(0, 1);
+                continue;
+            }
+
+            checksumSink += quint8(payload.isEmpty() ? 0 : payload.at(0));
+            ++frames;
+            buffer.remove(0, totalSize);
+        }
+        return frames;
+    }
+};
+
+struct Result
+{
+    qint64 nsecs = 0;
+    quint64 frames = 0;
+};
+
+void report(QTextStream &out, const char *name, const Result &r, qint64 bytes)
+{
+    const double seconds = r.nsecs / 1e9;
+    out << QStringLiteral("%1  %2 MB/s  %3 kframes/s  (%4 frames, %5 ms)\n")
+               .arg(QString::fromLatin1(name), -8)
+               .arg(bytes / seconds / 1e6, 8, 'f', 2)
+               .arg(r.frames / seconds / 1e3, 8, 'f', 1)
+               .arg(r.frames)
+               .arg(r.nsecs / 1e6, 0, 'f', 1);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const int iterations = argc > 1 ? QByteArray(argv[1]).toInt() : 20000;
+
+    // Several bursts back to back, then sliced like the UART delivers them
+    QByteArray stream;
+    for (int i = 0; i < 16; ++i)
+        stream.append(buildBurst());
+
+    QVector<QByteArray> chunks;
+    for (int offset = 0; offset < stream.size(); offset += ChunkSize)
+        chunks.append(stream.mid(offset, ChunkSize));
+
+    QTextStream out(stdout);
+    out << "Stream: " << stream.size() << " bytes in " << chunks.size()
+        << " chunks × " << iterations << " iterations\n";
+
+    Result legacy;
+    {
+        LegacyParser parser;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            for (const QByteArray &chunk : chunks)
+                legacy.frames += quint64(parser.feed(chunk));
+        }
+        legacy.nsecs = timer.nsecsElapsed();
+    }
+
+    Result ring;
+    {
+        SerialFrameParser parser;
+        quint64 sink = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            for (const QByteArray &chunk : chunks) {
+                parser.append(chunk.constData(), chunk.size());
+                ring.frames += quint64(parser.parse([&sink](quint8, const PayloadView &payload) {
+                    sink += payload.isEmpty() ? 0 : payload.at(0);
+                }));
+            }
+        }
+        ring.nsecs = timer.nsecsElapsed();
+        Q_UNUSED(sink)
+    }
+
+    const qint64 totalBytes = qint64(stream.size()) * iterations;
+    report(out, "legacy", legacy, totalBytes);
+    report(out, "ring", ring, totalBytes);
+    out << QStringLiteral("speedup  %1x\n").arg(double(legacy.nsecs) / ring.nsecs, 0, 'f', 2);
+
+    return legacy.frames == ring.frames ? 0 : 1;
+}
@@ -0,0 +1,721 @@
+// Hot-path micro-benchmarks: RX framing + dispatch, checksum, color
+// decoding, mixer value labels, name interning, clip grid storage, model
+// setters with a connected view, bulk ring handlers, meter ballistics.
+//
+// Build with -DPUSHCLONE_BUILD_BENCHMARKS=ON and run on the target (Pi 5):
+//   ./benchHotPaths --format json --output hot_paths.json
+//   ./benchHotPaths --filter 'model\.' --repeat 9
+
+#include <QCoreApplication>
+#include <QAbstractItemModel>
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <QVector>
+
+#include <array>
+#include <cmath>
+
+#include "BenchHarness.h"
+#include "ColorBatch.h"
+#include "MeterBallistics.h"
+#include "MixerValueTables.h"
+#include "NamePool.h"
+#include "ProtocolSchema.h"
+#include "SerialController.h"
+#include "SerialTxQueue.h"
+
+using namespace Protocol;
+
+namespace {
+
+constexpr int ChunkSize = 64;   // typical readyRead chunk from the UART driver
+
+QByteArray frame(quint8 cmd, const QByteArray &payload)
+{
+    QByteArray out;
+    SerialTxQueue::encodeFrame(out, cmd, reinterpret_cast<const quint8 *>(payload.constData()),
+                               int(payload.size()));
+    return out;
+}
+
+QByteArray bytes(std::initializer_list<int> values)
+{
+    QByteArray out;
+    for (int v : values)
+        out.append(char(v));
+    return out;
+}
+
+// ColorBatch against the per-color helpers, every byte value in every
+// component slot; returns the number of mismatching colors
+int verifyColorBatch()
+{
+    int mismatches = 0;
+
+    // 14-bit: all 65536 (msb, lsb) pairs, shifted across R, G and B
+    constexpr int Pairs = 1 << 16;
+    QVector<quint8> data14(Pairs * 6);
+    for (int i = 0; i < Pairs; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const int pair = (i + c * 21845) & 0xFFFF;
+            data14[i * 6 + c * 2] = quint8(pair >> 8);
+            data14[i * 6 + c * 2 + 1] = quint8(pair & 0xFF);
+        }
+    }
+    QVector<QRgb> out(Pairs);
+    ColorBatch::decodeRgb14(data14.constData(), Pairs, out.data());
+    for (int i = 0; i < Pairs; ++i)
+        mismatches += out[i] != rgbFrom14(data14.constData() + i * 6) ? 1 : 0;
+
+    // 7-bit grid and bulk clips: every byte value in every slot
+    constexpr int Bytes = 256 * 4;
+    QVector<quint8> data(Bytes * 4);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = quint8((i * 7 + i / 256) & 0xFF);
+    ColorBatch::decodeRgb7(data.constData(), Bytes, out.data());
+    for (int i = 0; i < Bytes; ++i)
+        mismatches += out[i] != rgbFrom7(data.constData() + i * 3) ? 1 : 0;
+
+    QVector<quint8> states(Bytes);
+    ColorBatch::decodeClips(data.constData(), Bytes, states.data(), out.data());
+    for (int i = 0; i < Bytes; ++i) {
+        const quint8 *p = data.constData() + i * 4;
+        const QColor legacy(quint8((p[1] & 0x7F) << 1), quint8((p[2] & 0x7F) << 1), quint8((p[3] & 0x7F) << 1));
+        mismatches += (states[i] != (p[0] & 0x7F) || out[i] != legacy.rgb()) ? 1 : 0;
+    }
+    return mismatches;
+}
+
+// Pre-SoA ClipGridModel cell, kept for comparison
+struct LegacyClipCell {
+    int track = 0;
+    int scene = 0;
+    QString name;
+    int state = 0;
+    QColor color = QColor("#282828");
+};
+
+// Pre-table MixerModel label formatting, kept for comparison
+QString legacyVolumeLabel(float volume)
+{
+    if (volume < 0.001f)
+        return QStringLiteral("-∞");
+    const float db = 20.0f * std::log10(volume);
+    if (db > -0.5f)
+        return QStringLiteral("0.0 dB");
+    if (db < -60.0f)
+        return QStringLiteral("-∞");
+    return QString("%1 dB").arg(db, 0, 'f', 1);
+}
+
+QString legacyPanLabel(float pan)
+{
+    if (pan < 0.48f || pan > 0.52f) {
+        const int steps = static_cast<int>((pan - 0.5f) * 50.0f);
+        return steps < 0 ? QString("L%1").arg(-steps) : QString("R%1").arg(steps);
+    }
+    return QStringLiteral("C");
+}
+
+// Stand-in for a QML delegate: re-reads every changed role of every changed
+// row, the way bindings re-evaluate on dataChanged.
+class DummyView
+{
+public:
+    explicit DummyView(QAbstractItemModel *model)
+        : m_model(model)
+    {
+        const QList<int> allRoles = model->roleNames().keys();
+        m_allRoles = QVector<int>(allRoles.begin(), allRoles.end());
+        QObject::connect(model, &QAbstractItemModel::dataChanged, model,
+                         [this](const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                const QVector<int> &roles) {
+            ++m_emissions;
+            const QVector<int> &read = roles.isEmpty() ? m_allRoles : roles;
+            for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                const QModelIndex index = m_model->index(row, 0);
+                for (int role : read) {
+                    benchDoNotOptimize(m_model->data(index, role));
+                    ++m_roleReads;
+                }
+            }
+        });
+    }
+
+    void reset() { m_emissions = 0; m_roleReads = 0; }
+    quint64 emissions() const { return m_emissions; }
+    quint64 roleReads() const { return m_roleReads; }
+
+private:
+    QAbstractItemModel *m_model;
+    QVector<int> m_allRoles;
+    quint64 m_emissions = 0;
+    quint64 m_roleReads = 0;
+};
+
+// Mixed live traffic: fader moves, clip states, pad colors, tempo
+QByteArray buildLiveStream()
+{
+    QByteArray stream;
+    for (int step = 0; step < 64; ++step) {
+        for (int t = 0; t < 8; ++t)
+            stream.append(frame(CmdMixerVolume, bytes({ t, (step * 3) & 0x7F, (step * 7 + t) & 0x7F })));
+        stream.append(frame(CmdClipState, bytes({ step % 8, step % 4, step % 3 })));
+        stream.append(frame(CmdPadUpdate14bit, bytes({ step % 8, step % 4, 1, step & 0x7F, 0, 0x40, 1, 0 })));
+        stream.append(frame(CmdTransportTempo, bytes({ 9, (step * 5) & 0x7F })));
+    }
+    return stream;
+}
+
+// 32 × [state, R7, G7, B7], varied per call so models see real changes
+QByteArray ringClipsBody(int variant)
+{
+    QByteArray body;
+    for (int i = 0; i < 32; ++i) {
+        body.append(char((i + variant) % 4));
+        body.append(char((i * 3 + variant * 11) & 0x7F));
+        body.append(char((i * 5 + variant * 13) & 0x7F));
+        body.append(char((i * 7 + variant * 17) & 0x7F));
+    }
+    return body;
+}
+
+QByteArray ringClipsFrame(int variant)
+{
+    return frame(CmdSessionRingClips, ringClipsBody(variant));
+}
+
+// CMD_PREFETCH_CLIPS: window offsets + the same body as ringClipsFrame
+QByteArray prefetchClipsFrame(int trackOffset, int sceneOffset, int variant)
+{
+    QByteArray payload = bytes({ (trackOffset >> 7) & 0x7F, trackOffset & 0x7F,
+                                 (sceneOffset >> 7) & 0x7F, sceneOffset & 0x7F });
+    payload.append(ringClipsBody(variant));
+    return frame(CmdPrefetchClips, payload);
+}
+
+QByteArray ringPositionFrame(int trackOffset, int sceneOffset)
+{
+    return frame(CmdRingPosition, bytes({ (trackOffset >> 7) & 0x7F, trackOffset & 0x7F,
+                                          (sceneOffset >> 7) & 0x7F, sceneOffset & 0x7F, 8, 4, 0 }));
+}
+
+QByteArray ringMetadataFrame(int variant)
+{
+    QByteArray payload;
+    payload.append(char(8));
+    for (int t = 0; t < 8; ++t) {
+        const QByteArray name = QByteArray(variant ? "Bus " : "Track ") + QByteArray::number(t + 1);
+        payload.append(char(name.size())).append(name);
+        payload.append(char(0x40 ^ variant)).append(char(0x20)).append(char(0x10 + t));
+    }
+    payload.append(char(4));
+    for (int s = 0; s < 4; ++s) {
+        const QByteArray name = QByteArray(variant ? "Verse " : "Scene ") + QByteArray::number(s + 1);
+        payload.append(char(name.size())).append(name);
+        payload.append(char(0x10)).append(char(0x20 ^ variant)).append(char(0x40));
+    }
+    return frame(CmdSessionRingMetadata, payload);
+}
+
+QByteArray gridUpdate14Frame(int variant)
+{
+    QByteArray payload;
+    for (int i = 0; i < 32 && payload.size() + 6 <= MaxLen; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const int value = (i * 37 + c * 71 + variant * 101) & 0xFF;
+            payload.append(char(value >> 7)).append(char(value & 0x7F));
+        }
+    }
+    return frame(CmdGridUpdate14bit, payload);
+}
+
+// Four changed pads: dirty mask + 4 × Rgb14 instead of the full grid
+QByteArray gridDelta14Frame(int variant)
+{
+    const quint32 mask = (1u << 3) | (1u << 9) | (1u << 20) | (1u << 31);
+    quint8 maskBytes[Mask32Size];
+    encodeMask32(mask, maskBytes);
+    QByteArray payload(reinterpret_cast<const char *>(maskBytes), Mask32Size);
+    for (int i = 0; i < 4; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const int value = (i * 37 + c * 71 + variant * 101) & 0xFF;
+            payload.append(char(value >> 7)).append(char(value & 0x7F));
+        }
+    }
+    return frame(CmdGridDelta14bit, payload);
+}
+
+// One meter tick for 8 tracks
+QByteArray trackMetersFrame(int variant)
+{
+    QByteArray payload;
+    payload.append(char(0));
+    for (int i = 0; i < 16; ++i)
+        payload.append(char((i * 13 + variant * 29) & 0x7F));
+    return frame(CmdTrackMeters, payload);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    BenchSuite suite(QStringLiteral("hot_paths"), app);
+
+    // Keep the console quiet; the controller may fail to open /dev/serial0
+    QLoggingCategory::setFilterRules(QStringLiteral("pushclone.*=false"));
+
+    SerialController controller;
+
+    // ── RX framing + dispatch ─────────────────────────────
+    {
+        const QByteArray stream = buildLiveStream();
+        QVector<QByteArray> chunks;
+        for (int offset = 0; offset < stream.size(); offset += ChunkSize)
+            chunks.append(stream.mid(offset, ChunkSize));
+
+        suite.run(QStringLiteral("rx.live_stream"), 200, [&]() {
+            for (const QByteArray &chunk : chunks)
+                controller.injectRxBytes(chunk.constData(), int(chunk.size()));
+        }, double(stream.size()), 64.0 * 11.0);
+    }
+
+    // ── Checksum ──────────────────────────────────────────
+    {
+        constexpr int Len = SerialFrameParser::MaxPayloadV1;
+        std::array<quint8, SerialFrameParser::MaxPayload> payload;
+        for (int i = 0; i < SerialFrameParser::MaxPayload; ++i)
+            payload[i] = quint8(i * 31);
+        suite.run(QStringLiteral("checksum.255"), 200000, [&]() {
+            benchDoNotOptimize(SerialFrameParser::checksum(0x9B, payload.data(), Len));
+        }, double(Len));
+        suite.run(QStringLiteral("crc16.1024"), 50000, [&]() {
+            benchDoNotOptimize(SerialFrameParser::crc16(payload.data(), SerialFrameParser::MaxPayload));
+        }, double(SerialFrameParser::MaxPayload));
+
+        QByteArray encoded;
+        encoded.reserve(SerialFrameParser::MaxEncodedV2);
+        suite.run(QStringLiteral("encode_v2.1024"), 50000, [&]() {
+            encoded.resize(0);
+            SerialTxQueue::encodeFrame(encoded, 0x9B, payload.data(), SerialFrameParser::MaxPayload,
+                                       SerialFrameParser::FramingV2);
+            benchDoNotOptimize(encoded.size());
+        }, double(SerialFrameParser::MaxPayload));
+    }
+
+    // ── Meter ballistics (one display frame per op) ───────
+    for (const int channels : { 64, 128 }) {
+        MeterBallistics meters;
+        meters.setChannelCount(channels);
+        int n = 0;
+        suite.run(QStringLiteral("meters.ballistics.%1ch").arg(channels), 100000, [&]() {
+            // A new meter frame lands every other display frame at 60 Hz
+            if (++n & 1) {
+                float *targets = meters.targets();
+                for (int c = 0; c < channels; ++c)
+                    targets[c] = float((n * 7 + c * 13) & 0x7F) * (1.0f / 127.0f);
+            }
+            benchDoNotOptimize(meters.step(1.0f / 60.0f));
+        }, 0.0, double(channels));
+    }
+
+    // ── Color decoding ────────────────────────────────────
+    {
+        constexpr int Colors = 256;
+        std::array<quint8, Colors * 6> packed14;
+        std::array<quint8, Colors * 3> packed7;
+        for (int i = 0; i < Colors; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                const int value = (i * 7 + c * 85) & 0xFF;
+                packed14[i * 6 + c * 2] = quint8(value >> 7);
+                packed14[i * 6 + c * 2 + 1] = quint8(value & 0x7F);
+                packed7[i * 3 + c] = quint8(value >> 1);
+            }
+        }
+
+        suite.run(QStringLiteral("color.colorFrom14"), 20000, [&]() {
+            for (int i = 0; i < Colors; ++i)
+                benchDoNotOptimize(colorFrom14(packed14.data() + i * 6));
+        }, 0.0, Colors);
+        suite.run(QStringLiteral("color.colorFrom7"), 20000, [&]() {
+            for (int i = 0; i < Colors; ++i)
+                benchDoNotOptimize(colorFrom7(packed7.data() + i * 3));
+        }, 0.0, Colors);
+        suite.run(QStringLiteral("color.rgbFrom14"), 20000, [&]() {
+            for (int i = 0; i < Colors; ++i)
+                benchDoNotOptimize(rgbFrom14(packed14.data() + i * 6));
+        }, 0.0, Colors);
+        suite.run(QStringLiteral("color.rgbFrom7"), 20000, [&]() {
+            for (int i = 0; i < Colors; ++i)
+                benchDoNotOptimize(rgbFrom7(packed7.data() + i * 3));
+        }, 0.0, Colors);
+
+        // Whole payload in one pass (backend: ColorBatch::backend())
+        if (const int mismatches = verifyColorBatch()) {
+            QTextStream(stderr) << "ColorBatch (" << ColorBatch::backend() << ") differs from the per-color helpers on "
+                                << mismatches << " inputs\n";
+            return 1;
+        }
+        std::array<QRgb, Colors> out;
+        std::array<quint8, Colors> states;
+        suite.run(QStringLiteral("color.batch.rgb14"), 20000, [&]() {
+            ColorBatch::decodeRgb14(packed14.data(), Colors, out.data());
+            benchDoNotOptimize(out);
+        }, 0.0, Colors);
+        suite.run(QStringLiteral("color.batch.rgb7"), 20000, [&]() {
+            ColorBatch::decodeRgb7(packed7.data(), Colors, out.data());
+            benchDoNotOptimize(out);
+        }, 0.0, Colors);
+
+        // Ring clip bodies: the handler's former per-clip shift + QColor
+        // vs. one batch pass (packed14 reused as [state, R7, G7, B7] bytes)
+        suite.run(QStringLiteral("color.clips.scalar"), 20000, [&]() {
+            for (int i = 0; i < Colors; ++i) {
+                const quint8 *p = packed14.data() + i * 4;
+                states[i] = p[0] & 0x7F;
+                out[i] = QColor(quint8((p[1] & 0x7F) << 1), quint8((p[2] & 0x7F) << 1),
+                                quint8((p[3] & 0x7F) << 1)).rgb();
+            }
+            benchDoNotOptimize(out);
+        }, 0.0, Colors);
+        suite.run(QStringLiteral("color.batch.clips"), 20000, [&]() {
+            ColorBatch::decodeClips(packed14.data(), Colors, states.data(), out.data());
+            benchDoNotOptimize(out);
+        }, 0.0, Colors);
+    }
+
+    // ── Mixer value decoding (14-bit → float + label) ─────
+    {
+        constexpr int Values = 256;
+        const MixerValueTables &tables = MixerValueTables::instance();
+        quint16 value = 0;
+
+        suite.run(QStringLiteral("mixer.label.volume.format"), 2000, [&]() {
+            for (int i = 0; i < Values; ++i) {
+                value = quint16((value + 97) & MixerValueTables::MaxValue);
+                benchDoNotOptimize(legacyVolumeLabel(value / 16383.0f));
+            }
+        }, 0.0, Values);
+        suite.run(QStringLiteral("mixer.label.volume.table"), 2000, [&]() {
+            for (int i = 0; i < Values; ++i) {
+                value = quint16((value + 97) & MixerValueTables::MaxValue);
+                benchDoNotOptimize(QString(tables.volumeLabel(value)));
+            }
+        }, 0.0, Values);
+        suite.run(QStringLiteral("mixer.label.pan.format"), 2000, [&]() {
+            for (int i = 0; i < Values; ++i) {
+                value = quint16((value + 97) & MixerValueTables::MaxValue);
+                benchDoNotOptimize(legacyPanLabel(value / 16383.0f));
+            }
+        }, 0.0, Values);
+        suite.run(QStringLiteral("mixer.label.pan.table"), 2000, [&]() {
+            for (int i = 0; i < Values; ++i) {
+                value = quint16((value + 97) & MixerValueTables::MaxValue);
+                benchDoNotOptimize(QString(tables.panLabel(value)));
+            }
+        }, 0.0, Values);
+    }
+
+    // ── Name decoding (bulk metadata, 7-bit) ──────────────
+    // Per-character QString building as the metadata handler used to do
+    // vs. interning; after the first pass every intern is a hit.
+    {
+        const QByteArray names[8] = { "Audio", "MIDI", "Drums", "Bass", "Keys", "Vox", "FX Return", "Master" };
+        NamePool &pool = NamePool::instance();
+
+        suite.run(QStringLiteral("names.qstring.x8"), 20000, [&]() {
+            for (const QByteArray &bytes : names) {
+                QString name;
+                for (char c : bytes)
+                    name.append(QChar(c & 0x7F));
+                benchDoNotOptimize(name);
+            }
+        }, 0.0, 8);
+        suite.run(QStringLiteral("names.intern.x8"), 20000, [&]() {
+            for (const QByteArray &bytes : names)
+                benchDoNotOptimize(pool.intern7bit(reinterpret_cast<const quint8 *>(bytes.constData()),
+                                                   int(bytes.size())));
+        }, 0.0, 8);
+    }
+
+    // ── Clip grid storage: array of structs vs. struct of arrays ──
+    // Same compare-and-store a 32-pad color update does, and the
+    // QVariants a delegate reads back (name, state, color per cell).
+    {
+        constexpr int Cells = ClipGridModel::Cells;
+        const QRgb rgb[2] = { qRgb(255, 0, 0), qRgb(0, 0, 255) };
+        QVector<LegacyClipCell> cells(Cells);
+        std::array<QRgb, Cells> colors;
+        std::array<quint8, Cells> states {};
+        std::array<QString, Cells> names;
+        colors.fill(ClipGridModel::DefaultColor);
+        int n = 0;
+
+        suite.run(QStringLiteral("storage.clip.aos.colors.x32"), 20000, [&]() {
+            ++n;
+            int changed = 0;
+            for (int i = 0; i < Cells; ++i) {
+                const QColor color(rgb[(n + i) & 1]);
+                if (cells[i].color != color) {
+                    cells[i].color = color;
+                    ++changed;
+                }
+            }
+            benchDoNotOptimize(changed);
+        }, 0.0, Cells);
+        suite.run(QStringLiteral("storage.clip.soa.colors.x32"), 20000, [&]() {
+            ++n;
+            int changed = 0;
+            for (int i = 0; i < Cells; ++i) {
+                const QRgb color = rgb[(n + i) & 1];
+                if (colors[i] != color) {
+                    colors[i] = color;
+                    ++changed;
+                }
+            }
+            benchDoNotOptimize(changed);
+        }, 0.0, Cells);
+
+        suite.run(QStringLiteral("storage.clip.aos.data.x32"), 5000, [&]() {
+            for (const LegacyClipCell &cell : cells) {
+                benchDoNotOptimize(QVariant(cell.name));
+                benchDoNotOptimize(QVariant(cell.state));
+                benchDoNotOptimize(QVariant(cell.color));
+            }
+        }, 0.0, Cells);
+        suite.run(QStringLiteral("storage.clip.soa.data.x32"), 5000, [&]() {
+            for (int i = 0; i < Cells; ++i) {
+                benchDoNotOptimize(QVariant(names[i]));
+                benchDoNotOptimize(QVariant(int(states[i])));
+                benchDoNotOptimize(QVariant(QColor(colors[i])));
+            }
+        }, 0.0, Cells);
+    }
+
+    // ── Model setters with a connected view ───────────────
+    // Values alternate so every call really changes the row and emits.
+    {
+        ClipGridModel clips;
+        DummyView view(&clips);
+        const QColor colors[2] = { QColor(255, 0, 0), QColor(0, 0, 255) };
+        int n = 0;
+
+        view.reset();
+        suite.run(QStringLiteral("model.clip.setClipColor"), 20000, [&]() {
+            ++n;
+            clips.setClipColor(n % 8, (n / 8) % 4, colors[(n / 32) & 1]);
+        });
+        suite.setLastItemsPerOp(double(view.roleReads()) / qMax<quint64>(1, view.emissions()));
+
+        suite.run(QStringLiteral("model.clip.setClipState"), 20000, [&]() {
+            ++n;
+            clips.setClipState(n % 8, (n / 8) % 4, (n / 32) & 1);
+        });
+        suite.run(QStringLiteral("model.clip.setClipName"), 20000, [&]() {
+            ++n;
+            clips.setClipName(n % 8, (n / 8) % 4, (n / 32) & 1 ? QStringLiteral("Bass") : QStringLiteral("Drums"));
+        });
+
+        // Full-grid repaint: 32 per-cell emissions vs. one batched emission
+        quint64 ops = 0;
+        view.reset();
+        suite.run(QStringLiteral("model.clip.setClipColor.x32"), 2000, [&]() {
+            ++n;
+            ++ops;
+            for (int i = 0; i < ClipGridModel::Cells; ++i)
+                clips.setClipColor(i % 8, i / 8, colors[(n + i) & 1]);
+        });
+        suite.setLastItemsPerOp(double(view.emissions()) / qMax<quint64>(1, ops));
+
+        ops = 0;
+        view.reset();
+        suite.run(QStringLiteral("model.clip.batch.x32"), 2000, [&]() {
+            ++n;
+            ++ops;
+            ClipGridModel::Batch batch(&clips);
+            for (int i = 0; i < ClipGridModel::Cells; ++i)
+                clips.setClipColor(i % 8, i / 8, colors[(n + i) & 1]);
+        });
+        suite.setLastItemsPerOp(double(view.emissions()) / qMax<quint64>(1, ops));
+
+        // What a delegate pays per cell on a full repaint
+        suite.run(QStringLiteral("model.clip.data.x32"), 5000, [&]() {
+            for (int row = 0; row < ClipGridModel::Cells; ++row) {
+                const QModelIndex index = clips.index(row);
+                benchDoNotOptimize(clips.data(index, ClipGridModel::NameRole));
+                benchDoNotOptimize(clips.data(index, ClipGridModel::StateRole));
+                benchDoNotOptimize(clips.data(index, ClipGridModel::ColorRole));
+            }
+        }, 0.0, ClipGridModel::Cells);
+    }
+    {
+        TrackListModel tracks;
+        DummyView view(&tracks);
+        int n = 0;
+        suite.run(QStringLiteral("model.track.setTrackName"), 20000, [&]() {
+            ++n;
+            tracks.setTrackName(n % 8, (n / 8) & 1 ? QStringLiteral("Keys") : QStringLiteral("Vox"));
+        });
+        suite.run(QStringLiteral("model.track.setTrackColor"), 20000, [&]() {
+            ++n;
+            tracks.setTrackColor(n % 8, (n / 8) & 1 ? QColor(10, 20, 30) : QColor(30, 20, 10));
+        });
+    }
+    {
+        MixerModel mixer;
+        DummyView view(&mixer);
+        int n = 0;
+        quint64 ops = 0;
+
+        // items/op: role reads by the view per setter call, i.e. the binding
+        // re-evaluations one update costs a channel strip
+        const auto bindingsPerUpdate = [&]() {
+            suite.setLastItemsPerOp(double(view.roleReads()) / qMax<quint64>(1, ops));
+            ops = 0;
+            view.reset();
+        };
+
+        view.reset();
+        suite.run(QStringLiteral("model.mixer.setTrackVolume"), 20000, [&]() {
+            ++n;
+            ++ops;
+            mixer.setTrackVolume(n % 8, float(n % 128) / 127.0f);
+        });
+        bindingsPerUpdate();
+
+        // Same value again: compared and dropped, nothing for QML to do
+        suite.run(QStringLiteral("model.mixer.setTrackVolume.unchanged"), 20000, [&]() {
+            ++ops;
+            mixer.setTrackVolume(3, 0.5f);
+        });
+        bindingsPerUpdate();
+
+        suite.run(QStringLiteral("model.mixer.setTrackPan"), 20000, [&]() {
+            ++n;
+            ++ops;
+            mixer.setTrackPan(n % 8, float(n % 128) / 127.0f);
+        });
+        bindingsPerUpdate();
+        suite.run(QStringLiteral("model.mixer.setTrackSend"), 20000, [&]() {
+            ++n;
+            ++ops;
+            mixer.setTrackSend(n % 8, (n / 8) % 4, float(n % 128) / 127.0f);
+        });
+        bindingsPerUpdate();
+        suite.run(QStringLiteral("model.mixer.setTrackMuted"), 20000, [&]() {
+            ++n;
+            ++ops;
+            mixer.setTrackMuted(n % 8, (n / 8) & 1);
+        });
+        bindingsPerUpdate();
+
+        // Meter tick through the model (pre CMD_TRACK_METERS) vs. the store
+        view.reset();
+        suite.run(QStringLiteral("model.mixer.setTrackMeter.x8"), 5000, [&]() {
+            ++n;
+            for (int t = 0; t < 8; ++t)
+                mixer.setTrackMeter(t, float((n + t) % 128) / 127.0f, float((n * 3 + t) % 128) / 127.0f);
+        });
+        suite.setLastItemsPerOp(double(view.roleReads()) / qMax<quint64>(1, view.emissions()));
+    }
+
+    // ── Bulk ring handlers (framing included) ─────────────
+    {
+        const QByteArray clips[2] = { ringClipsFrame(0), ringClipsFrame(1) };
+        const QByteArray metadata[2] = { ringMetadataFrame(0), ringMetadataFrame(1) };
+        const QByteArray grid[2] = { gridUpdate14Frame(0), gridUpdate14Frame(1) };
+        const QByteArray gridDelta[2] = { gridDelta14Frame(0), gridDelta14Frame(1) };
+        const QByteArray meters[2] = { trackMetersFrame(0), trackMetersFrame(1) };
+        int n = 0;
+        quint64 ops = 0;
+
+        DummyView clipView(controller.clipModel());
+        DummyView trackView(controller.trackModel());
+
+        // items/op: clip dataChanged emissions per frame
+        clipView.reset();
+        suite.run(QStringLiteral("handler.session_ring_clips"), 5000, [&]() {
+            const QByteArray &f = clips[++n & 1];
+            ++ops;
+            controller.injectRxBytes(f.constData(), int(f.size()));
+        }, double(clips[0].size()));
+        suite.setLastItemsPerOp(double(clipView.emissions()) / qMax<quint64>(1, ops));
+        suite.run(QStringLiteral("handler.session_ring_metadata"), 5000, [&]() {
+            const QByteArray &f = metadata[++n & 1];
+            controller.injectRxBytes(f.constData(), int(f.size()));
+        }, double(metadata[0].size()));
+        ops = 0;
+        clipView.reset();
+        suite.run(QStringLiteral("handler.grid_update_14"), 5000, [&]() {
+            const QByteArray &f = grid[++n & 1];
+            ++ops;
+            controller.injectRxBytes(f.constData(), int(f.size()));
+        }, double(grid[0].size()));
+        suite.setLastItemsPerOp(double(clipView.emissions()) / qMax<quint64>(1, ops));
+        suite.run(QStringLiteral("handler.grid_delta_14"), 5000, [&]() {
+            const QByteArray &f = gridDelta[++n & 1];
+            controller.injectRxBytes(f.constData(), int(f.size()));
+        }, double(gridDelta[0].size()));
+        suite.run(QStringLiteral("handler.track_meters.8"), 20000, [&]() {
+            const QByteArray &f = meters[++n & 1];
+            controller.injectRxBytes(f.constData(), int(f.size()));
+        }, double(meters[0].size()), 8.0);
+
+        // Ring move back and forth between two windows whose clips are
+        // cached: the grid is repainted from the cache in the same call.
+        // items/op: clip dataChanged emissions per move
+        {
+            const QByteArray positions[2] = { ringPositionFrame(8, 4), ringPositionFrame(0, 0) };
+            for (int i = 0; i < 2; ++i) {
+                controller.injectRxBytes(positions[i].constData(), int(positions[i].size()));
+                controller.injectRxBytes(clips[i].constData(), int(clips[i].size()));
+            }
+            ops = 0;
+            clipView.reset();
+            suite.run(QStringLiteral("handler.ring_move.cached"), 5000, [&]() {
+                const QByteArray &f = positions[++n & 1];
+                ++ops;
+                controller.injectRxBytes(f.constData(), int(f.size()));
+            }, double(positions[0].size()));
+            suite.setLastItemsPerOp(double(clipView.emissions()) / qMax<quint64>(1, ops));
+
+            // A prefetched window only lands in the session cache: items/op
+            // (clip emissions) should stay at 0
+            const QByteArray prefetched[2] = { prefetchClipsFrame(16, 0, 0), prefetchClipsFrame(0, 8, 1) };
+            ops = 0;
+            clipView.reset();
+            suite.run(QStringLiteral("handler.prefetch_clips"), 5000, [&]() {
+                const QByteArray &f = prefetched[++n & 1];
+                ++ops;
+                controller.injectRxBytes(f.constData(), int(f.size()));
+            }, double(prefetched[0].size()));
+            suite.setLastItemsPerOp(double(clipView.emissions()) / qMax<quint64>(1, ops));
+        }
+
+        // Ring-move burst (clips + metadata) then one frame flush; items/op
+        // is dataChanged emissions across the models per frame
+        const auto burst = [&]() {
+            const int i = ++n & 1;
+            controller.injectRxBytes(clips[i].constData(), int(clips[i].size()));
+            controller.injectRxBytes(metadata[i].constData(), int(metadata[i].size()));
+            controller.notifyAfterAnimating();
+        };
+        for (const bool coalesce : { false, true }) {
+            controller.modelCoalescer()->setEnabled(coalesce);
+            ops = 0;
+            clipView.reset();
+            trackView.reset();
+            suite.run(coalesce ? QStringLiteral("frame.ring_burst.coalesced")
+                               : QStringLiteral("frame.ring_burst.direct"), 5000, [&]() {
+                ++ops;
+                burst();
+            }, double(clips[0].size() + metadata[0].size()));
+            suite.setLastItemsPerOp(double(clipView.emissions() + trackView.emissions())
+                                    / qMax<quint64>(1, ops));
+        }
+        controller.modelCoalescer()->setEnabled(false);
+    }
+
+    return suite.finish();
+}
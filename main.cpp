@@ -4,6 +4,7 @@
 #include <QQuickWindow>
 
 #include "SerialController.h"
+#include "FlightRecorder.h"
 
 int main(int argc, char *argv[])
 {
@@ -15,6 +16,9 @@ int main(int argc, char *argv[])
 
     QGuiApplication app(argc, argv);
 
+    // Last seconds of serial RX are written out if the process crashes
+    FlightRecorder::installCrashHandler();
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
     // Qt6 only: Set OpenGL rendering backend for better performance
     QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
@@ -49,5 +53,28 @@ int main(int argc, char *argv[])
         return -1;
 #endif
 
+    // Per-frame hooks: model notifications flush and meter ballistics step
+    // before sync, update latency tracing ends at the swap. With the basic
+    // render loop both signals are emitted on the GUI thread, so direct
+    // calls are safe.
+    const bool coalesceModels = qEnvironmentVariableIntValue("PUSHCLONE_COALESCE_OFF") == 0;
+    const auto rootObjects = engine.rootObjects();
+    for (QObject *root : rootObjects) {
+        if (auto window = qobject_cast<QQuickWindow *>(root)) {
+            if (coalesceModels) {
+                ModelUpdateCoalescer *coalescer = serialController->modelCoalescer();
+                QObject::connect(coalescer, &ModelUpdateCoalescer::frameRequested,
+                                 window, &QQuickWindow::update);
+                coalescer->setEnabled(true);
+            }
+            QObject::connect(window, &QQuickWindow::afterAnimating, serialController,
+                             [serialController]() { serialController->notifyAfterAnimating(); },
+                             Qt::DirectConnection);
+            QObject::connect(window, &QQuickWindow::frameSwapped, serialController,
+                             [serialController]() { serialController->notifyFrameSwapped(); },
+                             Qt::DirectConnection);
+        }
+    }
+
     return app.exec();
 }
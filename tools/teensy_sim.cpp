@@ -0,0 +1,578 @@
+// Teensy simulator on a pseudo-terminal, for headless load tests.
+//
+// Build with -DPUSHCLONE_BUILD_TOOLS=ON, then:
+//   ./pushcloneTeensySim --profile fader-sweep --rate 100 --link /tmp/pushclone-sim
+//   PUSHCLONE_PORT=/tmp/pushclone-sim ./appPushClone
+//
+// The simulator keeps sending CMD_HANDSHAKE "PUSHCLONE_GUI" until the GUI
+// replies, seeds the session ring, then runs the selected traffic profile.
+// Frames are encoded with SerialTxQueue::encodeFrame, the GUI's own framing;
+// --framing 2 offers COBS/CRC-16 framing in the handshake like new firmware;
+// --baud N also sends the full capability block and runs the link check
+// (the PTY has no real line rate, but the GUI side switches all the same).
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSocketNotifier>
+#include <QTextStream>
+#include <QTimer>
+#include <QtAlgorithms>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "ProtocolSchema.h"
+#include "SerialFrameParser.h"
+#include "SerialTxQueue.h"
+
+using namespace Protocol;
+
+namespace {
+
+constexpr qint64 MaxPendingBytes = 1 << 20;
+
+enum class Profile {
+    Idle,
+    RingStorm,     // ring moves: position + bulk metadata + bulk clips
+    FaderSweep,    // 8 volume faders, triangle waves
+    GridFlood,     // full 14-bit grid color updates
+    ClipChurn,     // random clip state + color changes
+    GridDelta,     // a few pads per step via the dirty-mask delta command
+    Meters,        // CMD_TRACK_METERS for 8 tracks
+    Mixed          // all of the above, round-robin
+};
+
+bool parseProfile(const QString &name, Profile *profile)
+{
+    static const struct { const char *name; Profile profile; } profiles[] = {
+        { "idle", Profile::Idle },
+        { "ring-storm", Profile::RingStorm },
+        { "fader-sweep", Profile::FaderSweep },
+        { "grid-flood", Profile::GridFlood },
+        { "clip-churn", Profile::ClipChurn },
+        { "grid-delta", Profile::GridDelta },
+        { "meters", Profile::Meters },
+        { "mixed", Profile::Mixed },
+    };
+    for (const auto &p : profiles) {
+        if (name == QLatin1String(p.name)) {
+            *profile = p.profile;
+            return true;
+        }
+    }
+    return false;
+}
+
+void append14(QByteArray &out, int value)
+{
+    out.append(char((value >> 7) & 0x7F));
+    out.append(char(value & 0x7F));
+}
+
+class TeensySimulator
+{
+public:
+    TeensySimulator(Profile profile, int rateHz, int burst, int framing, int baudRate)
+        : m_profile(profile)
+        , m_rateHz(qMax(1, rateHz))
+        , m_burst(qMax(1, burst))
+        , m_offeredFraming(framing)
+        , m_offeredBaud(baudRate)
+    {
+    }
+
+    bool open(const QString &linkPath)
+    {
+        m_fd = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (m_fd < 0 || ::grantpt(m_fd) != 0 || ::unlockpt(m_fd) != 0) {
+            m_err << "posix_openpt failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        ::fcntl(m_fd, F_SETFL, ::fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+
+        // Raw master side: no echo, no line discipline on our output
+        termios tio;
+        if (::tcgetattr(m_fd, &tio) == 0) {
+            ::cfmakeraw(&tio);
+            ::tcsetattr(m_fd, TCSANOW, &tio);
+        }
+
+        m_slavePath = QString::fromLocal8Bit(::ptsname(m_fd));
+        if (!linkPath.isEmpty()) {
+            QFile::remove(linkPath);
+            if (!QFile::link(m_slavePath, linkPath))
+                m_err << "Could not create link " << linkPath << "\n";
+            m_linkPath = linkPath;
+        }
+
+        m_readNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Read);
+        QObject::connect(m_readNotifier, &QSocketNotifier::activated, [this]() { readFromGui(); });
+        m_writeNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Write);
+        m_writeNotifier->setEnabled(false);
+        QObject::connect(m_writeNotifier, &QSocketNotifier::activated, [this]() { flushPending(); });
+
+        // While no GUI holds the slave open, reads fail with EIO: poll instead
+        m_reattachTimer.setInterval(250);
+        QObject::connect(&m_reattachTimer, &QTimer::timeout, [this]() {
+            m_reattachTimer.stop();
+            m_readNotifier->setEnabled(true);
+        });
+
+        m_handshakeTimer.setInterval(500);
+        QObject::connect(&m_handshakeTimer, &QTimer::timeout, [this]() { sendHandshake(); });
+
+        m_tickTimer.setTimerType(Qt::PreciseTimer);
+        m_tickTimer.setInterval(qMax(1, 1000 / m_rateHz));
+        QObject::connect(&m_tickTimer, &QTimer::timeout, [this]() { tick(); });
+
+        // After a baud switch: repeat CMD_LINK_CHECK until the GUI echoes it
+        m_linkCheckTimer.setInterval(100);
+        QObject::connect(&m_linkCheckTimer, &QTimer::timeout, [this]() {
+            if (m_linkCheckClock.elapsed() > LinkCheckTimeoutMs) {
+                m_out << "No link check echo, retrying without baud switch\n";
+                m_offeredBaud = 0;
+                disconnectGui("link check timeout");
+                return;
+            }
+            send(CmdLinkCheck, QByteArrayLiteral("PC"));
+        });
+
+        m_pingTimer.setInterval(1000);
+        QObject::connect(&m_pingTimer, &QTimer::timeout, [this]() { send(CmdPing, QByteArray()); });
+
+        m_reportTimer.setInterval(1000);
+        QObject::connect(&m_reportTimer, &QTimer::timeout, [this]() { report(); });
+
+        m_out << "PTY ready: " << m_slavePath;
+        if (!m_linkPath.isEmpty())
+            m_out << " (link " << m_linkPath << ")";
+        m_out << "\nWaiting for the GUI handshake...\n";
+        m_out.flush();
+
+        m_handshakeTimer.start();
+        m_reportTimer.start();
+        m_clock.start();
+        return true;
+    }
+
+    ~TeensySimulator()
+    {
+        if (!m_linkPath.isEmpty())
+            QFile::remove(m_linkPath);
+        delete m_readNotifier;
+        delete m_writeNotifier;
+        if (m_fd >= 0)
+            ::close(m_fd);
+    }
+
+private:
+    // ── Transport ─────────────────────────────────────────
+    void send(quint8 cmd, const QByteArray &payload)
+    {
+        if (m_pending.size() > MaxPendingBytes) {
+            ++m_framesDropped;
+            return;
+        }
+        SerialTxQueue::encodeFrame(m_pending, cmd, reinterpret_cast<const quint8 *>(payload.constData()),
+                                   int(payload.size()), m_framing);
+        ++m_framesSent;
+        flushPending();
+    }
+
+    void flushPending()
+    {
+        while (!m_pending.isEmpty()) {
+            const ssize_t n = ::write(m_fd, m_pending.constData(), size_t(m_pending.size()));
+            if (n > 0) {
+                m_bytesSent += n;
+                m_pending.remove(0, int(n));
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+                continue;
+            break;   // EAGAIN: the GUI is not draining fast enough
+        }
+        m_writeNotifier->setEnabled(!m_pending.isEmpty());
+    }
+
+    void readFromGui()
+    {
+        char buffer[512];
+        for (;;) {
+            const ssize_t n = ::read(m_fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                m_parser.append(buffer, int(n));
+                continue;
+            }
+            if (n < 0 && errno == EIO) {
+                // Slave side closed: GUI gone until it reopens the port
+                m_readNotifier->setEnabled(false);
+                m_reattachTimer.start();
+                if (m_connected)
+                    disconnectGui("port closed");
+            }
+            break;
+        }
+
+        m_parser.parse([this](quint8 cmd, const PayloadView &payload) {
+            ++m_framesReceived;
+            switch (cmd) {
+            case CmdHandshakeReply: {
+                LinkCaps agreed;
+                if (m_connected || m_linkCheckTimer.isActive() || !LinkCaps::decode(payload, &agreed))
+                    break;
+                const auto framing = agreed.framing >= SerialFrameParser::FramingV2 && m_offeredFraming >= 2
+                    ? SerialFrameParser::FramingV2 : SerialFrameParser::FramingV1;
+                if (agreed.baudRate == 0) {
+                    connectGui(framing);
+                    break;
+                }
+                m_framing = framing;
+                m_parser.setFramingVersion(framing);
+                m_handshakeTimer.stop();
+                m_out << "Switching to " << agreed.baudRate << " baud, checking link\n";
+                m_linkCheckClock.start();
+                m_linkCheckTimer.start();
+                break;
+            }
+            case CmdLinkCheck:
+                if (m_linkCheckTimer.isActive()) {
+                    m_linkCheckTimer.stop();
+                    connectGui(m_framing);
+                }
+                break;
+            case CmdPing:
+                // GUI latency probe: echo its sequence number untouched
+                if (m_connected && !payload.isEmpty())
+                    send(CmdPing, payload.toByteArray());
+                break;
+            case CmdDisconnect:
+                disconnectGui("CMD_DISCONNECT");
+                break;
+            case CmdRingPrefetch:
+                // Same bodies the ring would get there, tagged with the window
+                if (m_connected && payload.size() >= 4) {
+                    const int track = (payload[0] << 7) | payload[1];
+                    const int scene = (payload[2] << 7) | payload[3];
+                    QByteArray window;
+                    append14(window, track);
+                    append14(window, scene);
+                    send(CmdPrefetchMetadata, window + ringMetadata(track, scene));
+                    send(CmdPrefetchClips, window + ringClips(track, scene));
+                }
+                break;
+            default:
+                break;
+            }
+        });
+    }
+
+    // ── Session ───────────────────────────────────────────
+    void sendHandshake()
+    {
+        // Nobody on the slave side yet: don't pile up stale handshakes
+        if (m_reattachTimer.isActive())
+            return;
+        LinkCaps caps;
+        caps.framing = quint8(qBound(1, m_offeredFraming, 2));
+        if (m_offeredBaud > 0) {
+            caps.form = LinkCaps::Full;
+            caps.features = FeatureGridDelta | FeaturePingEcho | FeatureTrackMeters | FeatureRingPrefetch;
+            caps.maxPayload = quint16(caps.framing == 2 ? SerialFrameParser::MaxPayload
+                                                        : SerialFrameParser::MaxPayloadV1);
+            caps.baudRate = quint32(m_offeredBaud);
+        } else if (caps.framing == 2) {
+            caps.form = LinkCaps::WithFraming;
+        }
+        // Always in v1
+        m_framing = SerialFrameParser::FramingV1;
+        m_parser.setFramingVersion(SerialFrameParser::FramingV1);
+        send(CmdHandshake, caps.encode());
+    }
+
+    void connectGui(SerialFrameParser::FramingVersion framing)
+    {
+        m_connected = true;
+        m_framing = framing;
+        m_parser.setFramingVersion(framing);
+        m_handshakeTimer.stop();
+        m_out << "GUI connected (framing v" << int(framing) << "), profile running at " << m_rateHz << " Hz\n";
+        m_out.flush();
+
+        sendRingMove();
+        send(CmdTransportTempo, tempoPayload(1200));
+        m_tickTimer.start();
+        m_pingTimer.start();
+    }
+
+    void disconnectGui(const char *reason)
+    {
+        m_connected = false;
+        m_framing = SerialFrameParser::FramingV1;
+        m_parser.setFramingVersion(SerialFrameParser::FramingV1);
+        m_tickTimer.stop();
+        m_pingTimer.stop();
+        m_linkCheckTimer.stop();
+        m_pending.clear();
+        m_writeNotifier->setEnabled(false);
+        m_out << "GUI disconnected (" << reason << "), waiting for handshake\n";
+        m_out.flush();
+        m_handshakeTimer.start();
+    }
+
+    // ── Traffic profiles ──────────────────────────────────
+    void tick()
+    {
+        ++m_tick;
+        Profile profile = m_profile;
+        if (profile == Profile::Mixed)
+            profile = Profile(1 + int(m_tick % 6));
+
+        for (int i = 0; i < m_burst; ++i) {
+            switch (profile) {
+            case Profile::RingStorm: sendRingMove(); break;
+            case Profile::FaderSweep: sendFaderSweep(); break;
+            case Profile::GridFlood: sendGridFlood(); break;
+            case Profile::ClipChurn: sendClipChurn(); break;
+            case Profile::GridDelta: sendGridDelta(); break;
+            case Profile::Meters: sendMeters(); break;
+            case Profile::Idle:
+            case Profile::Mixed:
+                break;
+            }
+        }
+    }
+
+    static QByteArray tempoPayload(int bpmTimes10)
+    {
+        QByteArray payload;
+        append14(payload, bpmTimes10);
+        return payload;
+    }
+
+    void sendRingMove()
+    {
+        m_ringTrack = (m_ringTrack + 1) % 24;
+        m_ringScene = (m_ringScene + 1) % 12;
+
+        QByteArray position;
+        append14(position, m_ringTrack);
+        append14(position, m_ringScene);
+        position.append(char(8)).append(char(4)).append(char(0));
+        send(CmdRingPosition, position);
+
+        send(CmdSessionRingMetadata, ringMetadata(m_ringTrack, m_ringScene));
+        send(CmdSessionRingClips, ringClips(m_ringTrack, m_ringScene));
+    }
+
+    static QByteArray ringMetadata(int ringTrack, int ringScene)
+    {
+        QByteArray metadata;
+        metadata.append(char(8));
+        for (int t = 0; t < 8; ++t) {
+            const QByteArray name = QByteArray("Track ") + QByteArray::number(ringTrack + t + 1);
+            metadata.append(char(name.size())).append(name);
+            metadata.append(char((t * 16) & 0x7F)).append(char((ringTrack * 5) & 0x7F)).append(char(0x40));
+        }
+        metadata.append(char(4));
+        for (int s = 0; s < 4; ++s) {
+            const QByteArray name = QByteArray("Scene ") + QByteArray::number(ringScene + s + 1);
+            metadata.append(char(name.size())).append(name);
+            metadata.append(char(0x20)).append(char((s * 30) & 0x7F)).append(char(0x10));
+        }
+        return metadata;
+    }
+
+    static QByteArray ringClips(int ringTrack, int ringScene)
+    {
+        QByteArray clips;
+        for (int i = 0; i < 32; ++i) {
+            clips.append(char((i + ringTrack) % 4));
+            clips.append(char((i * 3 + ringScene * 7) & 0x7F));
+            clips.append(char((i * 5 + ringTrack * 11) & 0x7F));
+            clips.append(char((i * 7) & 0x7F));
+        }
+        return clips;
+    }
+
+    void sendFaderSweep()
+    {
+        // One full up/down sweep every two seconds, tracks phase-shifted
+        const double t = m_clock.elapsed() / 1000.0;
+        for (int track = 0; track < 8; ++track) {
+            const double phase = std::fmod(t * 0.5 + track / 8.0, 1.0);
+            const double level = phase < 0.5 ? phase * 2.0 : (1.0 - phase) * 2.0;
+            QByteArray payload;
+            payload.append(char(track));
+            append14(payload, int(level * 16383.0));
+            send(CmdMixerVolume, payload);
+        }
+    }
+
+    void sendGridFlood()
+    {
+        QByteArray payload;
+        for (int pad = 0; pad < 32; ++pad) {
+            const int base = int(m_tick * 7 + pad * 8);
+            append14(payload, base & 0xFF);
+            append14(payload, (base * 3) & 0xFF);
+            append14(payload, (255 - base) & 0xFF);
+        }
+        send(CmdGridUpdate14bit, payload);
+    }
+
+    void sendGridDelta()
+    {
+        quint32 mask = 0;
+        const int pads = 1 + std::rand() % 4;
+        for (int i = 0; i < pads; ++i)
+            mask |= 1u << (std::rand() % 32);
+
+        quint8 maskBytes[Mask32Size];
+        encodeMask32(mask, maskBytes);
+        QByteArray payload(reinterpret_cast<const char *>(maskBytes), Mask32Size);
+        for (quint32 bits = mask; bits; bits &= bits - 1) {
+            const int pad = int(qCountTrailingZeroBits(bits));
+            const int base = int(m_tick * 11 + pad * 8);
+            append14(payload, base & 0xFF);
+            append14(payload, (base * 5) & 0xFF);
+            append14(payload, (200 - base) & 0xFF);
+        }
+        send(CmdGridDelta14bit, payload);
+    }
+
+    void sendMeters()
+    {
+        // Decaying peaks with a random kick now and then, L slightly above R
+        QByteArray payload;
+        payload.append(char(0));
+        for (int track = 0; track < 8; ++track) {
+            float &level = m_meterLevels[track];
+            level = (std::rand() % 8 == 0) ? 0.6f + float(std::rand() % 40) / 100.0f : level * 0.85f;
+            payload.append(char(int(level * 127.0f) & 0x7F));
+            payload.append(char(int(level * 0.9f * 127.0f) & 0x7F));
+        }
+        send(CmdTrackMeters, payload);
+    }
+
+    void sendClipChurn()
+    {
+        for (int i = 0; i < 4; ++i) {
+            const int r = std::rand();
+            QByteArray payload;
+            payload.append(char(r % 8));          // track
+            payload.append(char((r >> 3) % 4));   // scene
+            payload.append(char((r >> 5) % 4));   // state
+            append14(payload, (r >> 7) & 0xFF);
+            append14(payload, (r >> 15) & 0xFF);
+            append14(payload, (r >> 23) & 0xFF);
+            send(CmdClipState, payload);
+        }
+    }
+
+    void report()
+    {
+        const qint64 bytes = m_bytesSent - m_lastBytesSent;
+        const quint64 frames = m_framesSent - m_lastFramesSent;
+        m_lastBytesSent = m_bytesSent;
+        m_lastFramesSent = m_framesSent;
+        if (!m_connected && frames <= 1)
+            return;
+        m_out << QStringLiteral("tx %1 frames/s  %2 KB/s  pending %3 B  dropped %4  rx %5 frames\n")
+                     .arg(frames, 6).arg(bytes / 1024.0, 7, 'f', 1).arg(m_pending.size(), 7)
+                     .arg(m_framesDropped).arg(m_framesReceived);
+        m_out.flush();
+    }
+
+    Profile m_profile;
+    float m_meterLevels[8] = {};
+    int m_rateHz;
+    int m_burst;
+    int m_offeredFraming;
+    int m_offeredBaud;
+    SerialFrameParser::FramingVersion m_framing = SerialFrameParser::FramingV1;
+    int m_fd = -1;
+    QString m_slavePath;
+    QString m_linkPath;
+    QSocketNotifier *m_readNotifier = nullptr;
+    QSocketNotifier *m_writeNotifier = nullptr;
+    QTimer m_reattachTimer;
+    QTimer m_handshakeTimer;
+    QTimer m_tickTimer;
+    QTimer m_pingTimer;
+    QTimer m_linkCheckTimer;
+    QElapsedTimer m_linkCheckClock;
+    QTimer m_reportTimer;
+    QElapsedTimer m_clock;
+    SerialFrameParser m_parser;
+    QByteArray m_pending;
+    bool m_connected = false;
+    quint64 m_tick = 0;
+    int m_ringTrack = 0;
+    int m_ringScene = 0;
+    quint64 m_framesSent = 0;
+    quint64 m_framesDropped = 0;
+    quint64 m_framesReceived = 0;
+    qint64 m_bytesSent = 0;
+    qint64 m_lastBytesSent = 0;
+    quint64 m_lastFramesSent = 0;
+    QTextStream m_out { stdout };
+    QTextStream m_err { stderr };
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("PushClone Teensy simulator on a pseudo-terminal"));
+    parser.addHelpOption();
+    QCommandLineOption profileOption(QStringLiteral("profile"),
+        QStringLiteral("idle, ring-storm, fader-sweep, grid-flood, clip-churn, grid-delta, meters or mixed"),
+        QStringLiteral("name"), QStringLiteral("mixed"));
+    QCommandLineOption rateOption(QStringLiteral("rate"), QStringLiteral("Profile ticks per second"),
+                                  QStringLiteral("hz"), QStringLiteral("50"));
+    QCommandLineOption burstOption(QStringLiteral("burst"), QStringLiteral("Profile steps per tick"),
+                                   QStringLiteral("n"), QStringLiteral("1"));
+    QCommandLineOption durationOption(QStringLiteral("duration"), QStringLiteral("Exit after N seconds (0 = run forever)"),
+                                      QStringLiteral("seconds"), QStringLiteral("0"));
+    QCommandLineOption framingOption(QStringLiteral("framing"), QStringLiteral("Highest framing version to offer (1 or 2)"),
+                                     QStringLiteral("version"), QStringLiteral("1"));
+    QCommandLineOption baudOption(QStringLiteral("baud"), QStringLiteral("Offer a baud switch to this rate (0 = none)"),
+                                  QStringLiteral("rate"), QStringLiteral("0"));
+    QCommandLineOption linkOption(QStringLiteral("link"), QStringLiteral("Symlink to the PTY slave, e.g. /tmp/pushclone-sim"),
+                                  QStringLiteral("path"));
+    parser.addOption(profileOption);
+    parser.addOption(rateOption);
+    parser.addOption(burstOption);
+    parser.addOption(durationOption);
+    parser.addOption(framingOption);
+    parser.addOption(baudOption);
+    parser.addOption(linkOption);
+    parser.process(app);
+
+    Profile profile = Profile::Mixed;
+    if (!parseProfile(parser.value(profileOption), &profile)) {
+        QTextStream(stderr) << "Unknown profile " << parser.value(profileOption) << "\n";
+        return 1;
+    }
+
+    TeensySimulator simulator(profile, parser.value(rateOption).toInt(), parser.value(burstOption).toInt(),
+                              parser.value(framingOption).toInt(), parser.value(baudOption).toInt());
+    if (!simulator.open(parser.value(linkOption)))
+        return 1;
+
+    const int duration = parser.value(durationOption).toInt();
+    if (duration > 0)
+        QTimer::singleShot(duration * 1000, &app, &QCoreApplication::quit);
+
+    return app.exec();
+}
@@ -0,0 +1,121 @@
+// Renders a TraceRing dump (SerialController::dumpTrace) as text.
+//
+// Build with -DPUSHCLONE_BUILD_TOOLS=ON:
+//   ./pushcloneTraceDecode trace.bin            one line per record
+//   ./pushcloneTraceDecode --csv trace.bin      sequence,time_us,kind,cmd,name,len,preview
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+
+#include <cstring>
+
+#include "ProtocolSchema.h"
+#include "TraceRing.h"
+
+namespace {
+
+const char *kindName(quint8 kind)
+{
+    switch (kind) {
+    case TraceRing::RxFrame: return "RX";
+    case TraceRing::TxFrame: return "TX";
+    case TraceRing::RxChunk: return "RXRAW";
+    case TraceRing::RxRejected: return "REJECT";
+    case TraceRing::RxChecksumError: return "CHKSUM";
+    default: return "?";
+    }
+}
+
+QString previewHex(const TraceRing::Record &r)
+{
+    if (r.kind == TraceRing::RxChunk)
+        return QString();
+    const int shown = qMin(int(r.len), int(TraceRing::PreviewBytes));
+    QString hex = QString::fromLatin1(
+        QByteArray(reinterpret_cast<const char *>(r.preview), shown).toHex(' '));
+    if (r.len > TraceRing::PreviewBytes)
+        hex += QStringLiteral(" …");
+    return hex;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Decode a PushClone trace ring dump"));
+    parser.addHelpOption();
+    QCommandLineOption csvOption(QStringLiteral("csv"), QStringLiteral("Emit CSV instead of text"));
+    parser.addOption(csvOption);
+    parser.addPositionalArgument(QStringLiteral("dump"), QStringLiteral("File written by dumpTrace()"));
+    parser.process(app);
+
+    QTextStream err(stderr);
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(1);
+    }
+
+    QFile file(parser.positionalArguments().constFirst());
+    if (!file.open(QIODevice::ReadOnly)) {
+        err << "Cannot open " << file.fileName() << ": " << file.errorString() << "\n";
+        return 1;
+    }
+
+    TraceRing::FileHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != qint64(sizeof(header))
+        || std::memcmp(header.magic, "PCTRACE", 8) != 0) {
+        err << "Not a PushClone trace dump\n";
+        return 1;
+    }
+    if (header.version != TraceRing::FileVersion || header.recordSize != sizeof(TraceRing::Record)) {
+        err << "Unsupported dump version " << header.version << " (record size "
+            << header.recordSize << ")\n";
+        return 1;
+    }
+
+    QVector<TraceRing::Record> records(int(header.recordCount));
+    const qint64 bytes = qint64(records.size()) * qint64(sizeof(TraceRing::Record));
+    if (file.read(reinterpret_cast<char *>(records.data()), bytes) != bytes) {
+        err << "Truncated dump\n";
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    const bool csv = parser.isSet(csvOption);
+    const qint64 origin = records.isEmpty() ? 0 : records.constFirst().timestampNs;
+
+    if (csv)
+        out << "sequence,time_us,kind,cmd,name,len,preview\n";
+
+    for (const TraceRing::Record &r : records) {
+        const double timeUs = (r.timestampNs - origin) / 1000.0;
+        const char *name = r.kind == TraceRing::RxChunk ? "" : Protocol::commandName(r.cmd);
+        const QString cmdName = QString::fromLatin1(name ? name : "UNKNOWN");
+
+        if (csv) {
+            out << r.sequence << ',' << QString::number(timeUs, 'f', 1) << ','
+                << kindName(r.kind) << ',' << QStringLiteral("0x%1").arg(r.cmd, 2, 16, QLatin1Char('0'))
+                << ',' << cmdName << ',' << r.len << ',' << previewHex(r) << '\n';
+            continue;
+        }
+
+        out << QStringLiteral("%1 %2 us  %3").arg(r.sequence, 8).arg(timeUs, 14, 'f', 1)
+                   .arg(QString::fromLatin1(kindName(r.kind)), -6);
+        if (r.kind == TraceRing::RxChunk) {
+            out << QStringLiteral(" %1 bytes\n").arg(r.len);
+        } else {
+            out << QStringLiteral(" 0x%1 %2 len=%3  %4\n")
+                       .arg(r.cmd, 2, 16, QLatin1Char('0'))
+                       .arg(cmdName, -22)
+                       .arg(r.len, 3)
+                       .arg(previewHex(r));
+        }
+    }
+
+    return 0;
+}
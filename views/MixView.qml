@@ -16,6 +16,8 @@ Rectangle {
     // REAL MODEL CONNECTION
     // ═══════════════════════════════════════════════════════
     property var mixerModel: serialController.mixerModel
+    // Meters bypass the model: one levelsChanged per update for all tracks
+    property var meterStore: serialController.meterStore
 
     // Sync with model properties
     property int trackBank: mixerModel ? mixerModel.trackBank : 0
@@ -43,6 +45,19 @@ Rectangle {
         }
     }
 
+    function meterLevel(track, channel) {
+        // Reading revision makes the binding re-evaluate on levelsChanged
+        return meterStore && meterStore.revision >= 0 ? meterStore.level(track, channel) : 0;
+    }
+
+    function meterPeak(track, channel) {
+        return meterStore && meterStore.revision >= 0 ? meterStore.peak(track, channel) : 0;
+    }
+
+    function meterClipped(track) {
+        return meterStore && meterStore.revision >= 0 ? meterStore.clipped(track) : false;
+    }
+
     function nextTrackBank() {
         var maxBanks = Math.ceil(totalTracks / tracksPerBank);
         setTrackBank((trackBank + 1) % Math.max(1, maxBanks));
@@ -123,6 +138,63 @@ Rectangle {
                             }
                         }
 
+                        // Meters (L / R): level, held peak, clip latch (tap to clear)
+                        Row {
+                            id: meterRow
+                            width: parent.width
+                            spacing: 4
+                            property bool metered: trackDelegate.hasTrack && trackDelegate.inCurrentBank
+
+                            Column {
+                                width: parent.width - clipLed.width - parent.spacing
+                                spacing: 2
+                                anchors.verticalCenter: parent.verticalCenter
+
+                                Repeater {
+                                    model: 2
+                                    Rectangle {
+                                        width: parent.width
+                                        height: 4
+                                        radius: 2
+                                        color: PushCloneTheme.background
+
+                                        Rectangle {
+                                            width: meterRow.metered
+                                                   ? parent.width * root.meterLevel(trackDelegate.globalIndex, index) : 0
+                                            height: parent.height
+                                            radius: 2
+                                            color: index === 0 ? PushCloneTheme.primary : PushCloneTheme.success
+                                        }
+
+                                        Rectangle {
+                                            visible: meterRow.metered && x > 0
+                                            x: meterRow.metered
+                                               ? (parent.width - width) * root.meterPeak(trackDelegate.globalIndex, index) : 0
+                                            width: 2
+                                            height: parent.height
+                                            color: PushCloneTheme.text
+                                        }
+                                    }
+                                }
+                            }
+
+                            Rectangle {
+                                id: clipLed
+                                width: 10
+                                height: 10
+                                radius: 5
+                                color: meterRow.metered && root.meterClipped(trackDelegate.globalIndex)
+                                       ? PushCloneTheme.error : PushCloneTheme.background
+                                border.color: PushCloneTheme.border
+
+                                MouseArea {
+                                    anchors.fill: parent
+                                    anchors.margins: -6
+                                    onClicked: root.meterStore.clearClip(trackDelegate.globalIndex)
+                                }
+                            }
+                        }
+
                         // Volume
                         Column {
                             width: parent.width